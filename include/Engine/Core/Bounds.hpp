@@ -0,0 +1,140 @@
+#pragma once
+
+// Core bounds module: bounding volumes, planes and view frustum tests.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/Math.hpp"
+
+namespace ow {
+
+struct Aabb {
+    Vec3 min{0.0f, 0.0f, 0.0f};
+    Vec3 max{0.0f, 0.0f, 0.0f};
+
+    Vec3 Center() const { return (min + max) * 0.5f; }
+    Vec3 Extents() const { return (max - min) * 0.5f; }
+
+    bool Contains(const Aabb& other) const {
+        return other.min.x >= min.x && other.min.y >= min.y && other.min.z >= min.z &&
+               other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+    }
+
+    bool Overlaps(const Aabb& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+};
+
+inline Aabb Merge(const Aabb& a, const Aabb& b) {
+    return Aabb{
+        Vec3{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+        Vec3{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)},
+    };
+}
+
+// World-space AABB of a transformed local AABB (Arvo's method: abs of the 3x3 times extents).
+inline Aabb TransformAabb(const Aabb& local, const Mat4& m) {
+    const Vec3 c = local.Center();
+    const Vec3 e = local.Extents();
+    const Vec3 center{
+        m[0] * c.x + m[4] * c.y + m[8] * c.z + m[12],
+        m[1] * c.x + m[5] * c.y + m[9] * c.z + m[13],
+        m[2] * c.x + m[6] * c.y + m[10] * c.z + m[14],
+    };
+    const Vec3 extents{
+        std::fabs(m[0]) * e.x + std::fabs(m[4]) * e.y + std::fabs(m[8]) * e.z,
+        std::fabs(m[1]) * e.x + std::fabs(m[5]) * e.y + std::fabs(m[9]) * e.z,
+        std::fabs(m[2]) * e.x + std::fabs(m[6]) * e.y + std::fabs(m[10]) * e.z,
+    };
+    return Aabb{center - extents, center + extents};
+}
+
+struct BoundingSphere {
+    Vec3 center{0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+};
+
+// Conservative: the radius is scaled by the largest axis scale of m.
+inline BoundingSphere TransformSphere(const BoundingSphere& local, const Mat4& m) {
+    const Vec3 c = local.center;
+    const float sx = m[0] * m[0] + m[1] * m[1] + m[2] * m[2];
+    const float sy = m[4] * m[4] + m[5] * m[5] + m[6] * m[6];
+    const float sz = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+    return BoundingSphere{
+        Vec3{
+            m[0] * c.x + m[4] * c.y + m[8] * c.z + m[12],
+            m[1] * c.x + m[5] * c.y + m[9] * c.z + m[13],
+            m[2] * c.x + m[6] * c.y + m[10] * c.z + m[14],
+        },
+        local.radius * std::sqrt(std::max(sx, std::max(sy, sz))),
+    };
+}
+
+// Plane as dot(normal, p) + d = 0, normal pointing to the inside half-space.
+struct Plane {
+    Vec3 normal{0.0f, 1.0f, 0.0f};
+    float d = 0.0f;
+
+    float Distance(const Vec3& p) const { return Dot(normal, p) + d; }
+};
+
+struct Frustum {
+    enum Side { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+    Plane planes[Count];
+
+    // Gribb/Hartmann extraction from an OpenGL-style (clip z in [-w, w]) view-projection.
+    static Frustum FromMatrix(const Mat4& viewProjection) {
+        const Mat4& m = viewProjection;
+        auto row = [&m](int r) { return Vec4{m[r], m[4 + r], m[8 + r], m[12 + r]}; };
+        const Vec4 r0 = row(0);
+        const Vec4 r1 = row(1);
+        const Vec4 r2 = row(2);
+        const Vec4 r3 = row(3);
+
+        auto make = [](const Vec4& a, const Vec4& b, float sign) {
+            const Vec3 n{a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z};
+            const float len = Length(n);
+            const float inv = len > 0.00001f ? 1.0f / len : 0.0f;
+            return Plane{n * inv, (a.w + sign * b.w) * inv};
+        };
+
+        Frustum f;
+        f.planes[Left] = make(r3, r0, 1.0f);
+        f.planes[Right] = make(r3, r0, -1.0f);
+        f.planes[Bottom] = make(r3, r1, 1.0f);
+        f.planes[Top] = make(r3, r1, -1.0f);
+        f.planes[Near] = make(r3, r2, 1.0f);
+        f.planes[Far] = make(r3, r2, -1.0f);
+        return f;
+    }
+
+    bool Intersects(const BoundingSphere& sphere) const {
+        for (const Plane& plane : planes) {
+            if (plane.Distance(sphere.center) < -sphere.radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Intersects(const Aabb& box) const {
+        for (const Plane& plane : planes) {
+            // Farthest corner along the plane normal.
+            const Vec3 p{
+                plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                plane.normal.z >= 0.0f ? box.max.z : box.min.z,
+            };
+            if (plane.Distance(p) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace ow
@@ -0,0 +1,84 @@
+#pragma once
+
+// Core jobs module: fixed worker pool for chunked data-parallel loops.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ow {
+
+// Workers sleep until ParallelFor publishes a loop, then claim chunks from a shared
+// counter alongside the calling thread. One loop runs at a time and loops must not nest;
+// with zero workers every chunk runs inline on the caller.
+class JobSystem {
+public:
+    // One worker per hardware thread beyond the caller's.
+    static unsigned int DefaultWorkerCount();
+
+    explicit JobSystem(unsigned int workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int WorkerCount() const { return static_cast<unsigned int>(workers_.size()); }
+
+    // Splits [0, count) into chunks of chunkSize and calls fn(chunk, begin, end) for each,
+    // returning once every chunk has finished. Chunk indices are stable for a given
+    // count/chunkSize, so callers can write per-chunk results and merge them in order.
+    template <typename Fn>
+    void ParallelFor(std::size_t count, std::size_t chunkSize, Fn&& fn);
+
+    static std::size_t ChunkCount(std::size_t count, std::size_t chunkSize) {
+        return chunkSize == 0 ? 0 : (count + chunkSize - 1) / chunkSize;
+    }
+
+private:
+    void Run(std::size_t chunkCount, const std::function<void(std::size_t)>& job);
+    void WorkerLoop();
+    // Claims and runs chunks until none are left; returns how many it ran.
+    std::size_t Drain(const std::function<void(std::size_t)>& job, std::size_t chunkCount);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    // Current loop; generation_ changes each time one is published.
+    const std::function<void(std::size_t)>* job_ = nullptr;
+    std::size_t chunkCount_ = 0;
+    std::atomic<std::size_t> nextChunk_{0};
+    std::size_t finished_ = 0;
+    // Workers inside Drain; Run waits for zero so no worker outlives the loop's job.
+    unsigned int active_ = 0;
+    std::uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+template <typename Fn>
+void JobSystem::ParallelFor(std::size_t count, std::size_t chunkSize, Fn&& fn) {
+    const std::size_t chunks = ChunkCount(count, chunkSize);
+    if (chunks == 0) {
+        return;
+    }
+    auto runChunk = [&](std::size_t chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        fn(chunk, begin, end);
+    };
+    if (chunks == 1 || workers_.empty()) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            runChunk(chunk);
+        }
+        return;
+    }
+    Run(chunks, std::function<void(std::size_t)>(runChunk));
+}
+
+} // namespace ow
@@ -5,6 +5,8 @@
 #include <cmath>
 #include <cstddef>
 
+#include "Engine/Core/Simd.hpp"
+
 namespace ow {
 
 struct Vec2 {
@@ -33,6 +35,19 @@ struct Vec3 {
     }
 };
 
+struct Vec4 {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 0.0f;
+
+    Vec4() = default;
+    Vec4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+    Vec4(const Vec3& v, float w_) : x(v.x), y(v.y), z(v.z), w(w_) {}
+
+    Vec3 Xyz() const { return Vec3{x, y, z}; }
+};
+
 inline float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
 
 inline Vec3 Cross(const Vec3& a, const Vec3& b) {
@@ -58,6 +73,74 @@ inline float Radians(float degrees) {
     return degrees * (kPi / 180.0f);
 }
 
+// Unit quaternion rotation (x, y, z vector part, w scalar part).
+struct Quat {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 1.0f;
+
+    Quat() = default;
+    Quat(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+
+    static Quat Identity() { return Quat{}; }
+
+    static Quat FromAxisAngle(const Vec3& axis, float radians) {
+        const Vec3 n = Normalize(axis);
+        const float half = radians * 0.5f;
+        const float s = std::sin(half);
+        return Quat{n.x * s, n.y * s, n.z * s, std::cos(half)};
+    }
+
+    // Same convention as the Euler matrices: rotate about X, then Y, then Z.
+    static Quat FromEuler(const Vec3& radians) {
+        const float cx = std::cos(radians.x * 0.5f);
+        const float sx = std::sin(radians.x * 0.5f);
+        const float cy = std::cos(radians.y * 0.5f);
+        const float sy = std::sin(radians.y * 0.5f);
+        const float cz = std::cos(radians.z * 0.5f);
+        const float sz = std::sin(radians.z * 0.5f);
+        return Quat{
+            sx * cy * cz - cx * sy * sz,
+            cx * sy * cz + sx * cy * sz,
+            cx * cy * sz - sx * sy * cz,
+            cx * cy * cz + sx * sy * sz,
+        };
+    }
+};
+
+inline Quat operator*(const Quat& a, const Quat& b) {
+    return Quat{
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+    };
+}
+
+inline Quat Normalize(const Quat& q) {
+    const float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (len <= 0.00001f) {
+        return Quat::Identity();
+    }
+    const float inv = 1.0f / len;
+    return Quat{q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+inline Vec3 Rotate(const Quat& q, const Vec3& v) {
+    const Vec3 u{q.x, q.y, q.z};
+    const Vec3 t = Cross(u, v) * 2.0f;
+    return v + t * q.w + Cross(u, t);
+}
+
+// Column-major 3x3 matrix, used for normal transforms.
+struct Mat3 {
+    float m[9]{};
+
+    float& operator[](std::size_t index) { return m[index]; }
+    const float& operator[](std::size_t index) const { return m[index]; }
+};
+
 struct Mat4 {
     float m[16]{};
 
@@ -122,6 +205,114 @@ struct Mat4 {
         return result;
     }
 
+    // Rotation * scale written straight into the columns, translation into column 3.
+    // Equivalent to Translation(t) * Rotation(r) * Scale(s) without the intermediate products.
+    static Mat4 TRS(const Vec3& t, const Quat& r, const Vec3& s) {
+        const float xx = r.x * r.x;
+        const float yy = r.y * r.y;
+        const float zz = r.z * r.z;
+        const float xy = r.x * r.y;
+        const float xz = r.x * r.z;
+        const float yz = r.y * r.z;
+        const float wx = r.w * r.x;
+        const float wy = r.w * r.y;
+        const float wz = r.w * r.z;
+
+        Mat4 result;
+        result[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+        result[1] = 2.0f * (xy + wz) * s.x;
+        result[2] = 2.0f * (xz - wy) * s.x;
+
+        result[4] = 2.0f * (xy - wz) * s.y;
+        result[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+        result[6] = 2.0f * (yz + wx) * s.y;
+
+        result[8] = 2.0f * (xz + wy) * s.z;
+        result[9] = 2.0f * (yz - wx) * s.z;
+        result[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+
+        result[12] = t.x;
+        result[13] = t.y;
+        result[14] = t.z;
+        result[15] = 1.0f;
+        return result;
+    }
+
+    static Mat4 Rotation(const Quat& r) { return TRS(Vec3{0.0f, 0.0f, 0.0f}, r, Vec3{1.0f, 1.0f, 1.0f}); }
+
+    // Inverse of a matrix whose last row is (0, 0, 0, 1): invert the 3x3 part and
+    // transform the translation back. Much cheaper than a general 4x4 inverse.
+    static Mat4 AffineInverse(const Mat4& a) {
+        const float c00 = a[5] * a[10] - a[9] * a[6];
+        const float c01 = a[9] * a[2] - a[1] * a[10];
+        const float c02 = a[1] * a[6] - a[5] * a[2];
+        const float det = a[0] * c00 + a[4] * c01 + a[8] * c02;
+        if (std::fabs(det) <= 1e-12f) {
+            return Identity();
+        }
+        const float invDet = 1.0f / det;
+
+        Mat4 result = Identity();
+        result[0] = c00 * invDet;
+        result[1] = c01 * invDet;
+        result[2] = c02 * invDet;
+        result[4] = (a[8] * a[6] - a[4] * a[10]) * invDet;
+        result[5] = (a[0] * a[10] - a[8] * a[2]) * invDet;
+        result[6] = (a[4] * a[2] - a[0] * a[6]) * invDet;
+        result[8] = (a[4] * a[9] - a[8] * a[5]) * invDet;
+        result[9] = (a[8] * a[1] - a[0] * a[9]) * invDet;
+        result[10] = (a[0] * a[5] - a[4] * a[1]) * invDet;
+
+        result[12] = -(result[0] * a[12] + result[4] * a[13] + result[8] * a[14]);
+        result[13] = -(result[1] * a[12] + result[5] * a[13] + result[9] * a[14]);
+        result[14] = -(result[2] * a[12] + result[6] * a[13] + result[10] * a[14]);
+        return result;
+    }
+
+    // Inverse-transpose of the upper 3x3, i.e. what the shader needs for normals.
+    // Rotation + uniform scale is detected and returned as-is (shaders normalize anyway).
+    static Mat3 NormalMatrix(const Mat4& a) {
+        const Vec3 x{a[0], a[1], a[2]};
+        const Vec3 y{a[4], a[5], a[6]};
+        const Vec3 z{a[8], a[9], a[10]};
+
+        Mat3 result;
+        const float lx = Dot(x, x);
+        const float tolerance = 1e-4f * lx;
+        const bool uniform = std::fabs(Dot(y, y) - lx) <= tolerance && std::fabs(Dot(z, z) - lx) <= tolerance &&
+                             std::fabs(Dot(x, y)) <= tolerance && std::fabs(Dot(x, z)) <= tolerance &&
+                             std::fabs(Dot(y, z)) <= tolerance;
+        if (uniform) {
+            result[0] = x.x;
+            result[1] = x.y;
+            result[2] = x.z;
+            result[3] = y.x;
+            result[4] = y.y;
+            result[5] = y.z;
+            result[6] = z.x;
+            result[7] = z.y;
+            result[8] = z.z;
+            return result;
+        }
+
+        // Columns of the cofactor matrix; dividing by the determinant keeps the handedness right.
+        const Vec3 cx = Cross(y, z);
+        const Vec3 cy = Cross(z, x);
+        const Vec3 cz = Cross(x, y);
+        const float det = Dot(x, cx);
+        const float invDet = std::fabs(det) > 1e-12f ? 1.0f / det : 1.0f;
+        result[0] = cx.x * invDet;
+        result[1] = cx.y * invDet;
+        result[2] = cx.z * invDet;
+        result[3] = cy.x * invDet;
+        result[4] = cy.y * invDet;
+        result[5] = cy.z * invDet;
+        result[6] = cz.x * invDet;
+        result[7] = cz.y * invDet;
+        result[8] = cz.z * invDet;
+        return result;
+    }
+
     static Mat4 Perspective(float fovRadians, float aspect, float nearPlane, float farPlane) {
         Mat4 result{};
         const float tanHalf = std::tan(fovRadians * 0.5f);
@@ -158,18 +349,110 @@ struct Mat4 {
     }
 };
 
+// Column-major product: each result column is a linear combination of a's columns
+// weighted by the matching column of b.
 inline Mat4 operator*(const Mat4& a, const Mat4& b) {
-    Mat4 result{};
+    Mat4 result;
+#if defined(OW_SIMD_AVX2)
+    // Two result columns per 256-bit register; a's columns are duplicated into both halves.
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 12));
+    for (int col = 0; col < 4; col += 2) {
+        const __m256 bc = _mm256_loadu_ps(b.m + col * 4);
+        __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+        r = _mm256_fmadd_ps(a1, _mm256_permute_ps(bc, 0x55), r);
+        r = _mm256_fmadd_ps(a2, _mm256_permute_ps(bc, 0xAA), r);
+        r = _mm256_fmadd_ps(a3, _mm256_permute_ps(bc, 0xFF), r);
+        _mm256_storeu_ps(result.m + col * 4, r);
+    }
+#else
+    const simd::Float4 a0 = simd::Load(a.m + 0);
+    const simd::Float4 a1 = simd::Load(a.m + 4);
+    const simd::Float4 a2 = simd::Load(a.m + 8);
+    const simd::Float4 a3 = simd::Load(a.m + 12);
     for (int col = 0; col < 4; ++col) {
-        for (int row = 0; row < 4; ++row) {
-            float sum = 0.0f;
-            for (int i = 0; i < 4; ++i) {
-                sum += a[row + i * 4] * b[i + col * 4];
-            }
-            result[row + col * 4] = sum;
-        }
+        const simd::Float4 bc = simd::Load(b.m + col * 4);
+        simd::Float4 r = simd::Mul(a0, simd::SplatLane<0>(bc));
+        r = simd::MulAdd(a1, simd::SplatLane<1>(bc), r);
+        r = simd::MulAdd(a2, simd::SplatLane<2>(bc), r);
+        r = simd::MulAdd(a3, simd::SplatLane<3>(bc), r);
+        simd::Store(result.m + col * 4, r);
     }
+#endif
+    return result;
+}
+
+inline Vec4 operator*(const Mat4& a, const Vec4& v) {
+    simd::Float4 r = simd::Mul(simd::Load(a.m + 0), simd::Splat(v.x));
+    r = simd::MulAdd(simd::Load(a.m + 4), simd::Splat(v.y), r);
+    r = simd::MulAdd(simd::Load(a.m + 8), simd::Splat(v.z), r);
+    r = simd::MulAdd(simd::Load(a.m + 12), simd::Splat(v.w), r);
+
+    float out[4];
+    simd::Store(out, r);
+    return Vec4{out[0], out[1], out[2], out[3]};
+}
+
+inline Mat4 Transpose(const Mat4& a) {
+    simd::Float4 c0 = simd::Load(a.m + 0);
+    simd::Float4 c1 = simd::Load(a.m + 4);
+    simd::Float4 c2 = simd::Load(a.m + 8);
+    simd::Float4 c3 = simd::Load(a.m + 12);
+    simd::Transpose(c0, c1, c2, c3);
+
+    Mat4 result;
+    simd::Store(result.m + 0, c0);
+    simd::Store(result.m + 4, c1);
+    simd::Store(result.m + 8, c2);
+    simd::Store(result.m + 12, c3);
     return result;
 }
 
+// Batched kernel: out[i] = lhs * rhs[i]. Typically lhs is the view-projection and rhs the
+// model matrices, so lhs stays in registers for the whole batch. out may alias rhs.
+inline void MultiplyBatch(const Mat4& lhs, const Mat4* rhs, Mat4* out, std::size_t count) {
+#if defined(OW_SIMD_AVX2)
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 12));
+    for (std::size_t i = 0; i < count; ++i) {
+        const __m256 b01 = _mm256_loadu_ps(rhs[i].m + 0);
+        const __m256 b23 = _mm256_loadu_ps(rhs[i].m + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+
+        _mm256_storeu_ps(out[i].m + 0, r01);
+        _mm256_storeu_ps(out[i].m + 8, r23);
+    }
+#else
+    const simd::Float4 a0 = simd::Load(lhs.m + 0);
+    const simd::Float4 a1 = simd::Load(lhs.m + 4);
+    const simd::Float4 a2 = simd::Load(lhs.m + 8);
+    const simd::Float4 a3 = simd::Load(lhs.m + 12);
+    for (std::size_t i = 0; i < count; ++i) {
+        simd::Float4 cols[4];
+        for (int col = 0; col < 4; ++col) {
+            const simd::Float4 bc = simd::Load(rhs[i].m + col * 4);
+            simd::Float4 r = simd::Mul(a0, simd::SplatLane<0>(bc));
+            r = simd::MulAdd(a1, simd::SplatLane<1>(bc), r);
+            r = simd::MulAdd(a2, simd::SplatLane<2>(bc), r);
+            cols[col] = simd::MulAdd(a3, simd::SplatLane<3>(bc), r);
+        }
+        for (int col = 0; col < 4; ++col) {
+            simd::Store(out[i].m + col * 4, cols[col]);
+        }
+    }
+#endif
+}
+
 } // namespace ow
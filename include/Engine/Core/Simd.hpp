@@ -0,0 +1,318 @@
+#pragma once
+
+// Core SIMD module: thin 4/8-wide float abstraction over SSE, AVX2, NEON or plain scalar code.
+// The backend is picked at compile time; define OW_SIMD_SCALAR to force the portable path.
+
+#if !defined(OW_SIMD_SCALAR)
+#if defined(__AVX2__) && defined(__FMA__)
+#define OW_SIMD_AVX2 1
+#define OW_SIMD_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OW_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OW_SIMD_NEON 1
+#endif
+#endif
+
+#include <cmath>
+
+#if defined(OW_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(OW_SIMD_SSE)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#elif defined(OW_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ow::simd {
+
+#if defined(OW_SIMD_AVX2)
+inline constexpr const char* kBackendName = "AVX2";
+#elif defined(OW_SIMD_SSE)
+inline constexpr const char* kBackendName = "SSE2";
+#elif defined(OW_SIMD_NEON)
+inline constexpr const char* kBackendName = "NEON";
+#else
+inline constexpr const char* kBackendName = "SCALAR";
+#endif
+
+#if defined(OW_SIMD_SSE)
+
+struct Float4 {
+    __m128 v;
+};
+
+inline Float4 Load(const float* p) { return Float4{_mm_loadu_ps(p)}; }
+inline void Store(float* p, Float4 a) { _mm_storeu_ps(p, a.v); }
+inline Float4 Splat(float s) { return Float4{_mm_set1_ps(s)}; }
+inline Float4 Set(float x, float y, float z, float w) { return Float4{_mm_setr_ps(x, y, z, w)}; }
+inline Float4 Add(Float4 a, Float4 b) { return Float4{_mm_add_ps(a.v, b.v)}; }
+inline Float4 Sub(Float4 a, Float4 b) { return Float4{_mm_sub_ps(a.v, b.v)}; }
+inline Float4 Mul(Float4 a, Float4 b) { return Float4{_mm_mul_ps(a.v, b.v)}; }
+inline Float4 Div(Float4 a, Float4 b) { return Float4{_mm_div_ps(a.v, b.v)}; }
+inline Float4 Min(Float4 a, Float4 b) { return Float4{_mm_min_ps(a.v, b.v)}; }
+inline Float4 Max(Float4 a, Float4 b) { return Float4{_mm_max_ps(a.v, b.v)}; }
+inline Float4 Sqrt(Float4 a) { return Float4{_mm_sqrt_ps(a.v)}; }
+
+// Returns a * b + c.
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+#if defined(OW_SIMD_AVX2)
+    return Float4{_mm_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return Float4{_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+// Broadcasts lane N of a into all four lanes.
+template <int N>
+inline Float4 SplatLane(Float4 a) {
+    return Float4{_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(N, N, N, N))};
+}
+
+inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v);
+}
+
+struct Mask4 {
+    __m128 v;
+};
+
+inline Mask4 CmpGt(Float4 a, Float4 b) { return Mask4{_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask4 CmpLt(Float4 a, Float4 b) { return Mask4{_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask4 And(Mask4 a, Mask4 b) { return Mask4{_mm_and_ps(a.v, b.v)}; }
+inline Mask4 Or(Mask4 a, Mask4 b) { return Mask4{_mm_or_ps(a.v, b.v)}; }
+inline int MoveMask(Mask4 m) { return _mm_movemask_ps(m.v); }
+
+// Per lane: mask ? a : b.
+inline Float4 Select(Mask4 mask, Float4 a, Float4 b) {
+    return Float4{_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+}
+
+#elif defined(OW_SIMD_NEON)
+
+struct Float4 {
+    float32x4_t v;
+};
+
+inline Float4 Load(const float* p) { return Float4{vld1q_f32(p)}; }
+inline void Store(float* p, Float4 a) { vst1q_f32(p, a.v); }
+inline Float4 Splat(float s) { return Float4{vdupq_n_f32(s)}; }
+inline Float4 Set(float x, float y, float z, float w) {
+    const float values[4] = {x, y, z, w};
+    return Float4{vld1q_f32(values)};
+}
+inline Float4 Add(Float4 a, Float4 b) { return Float4{vaddq_f32(a.v, b.v)}; }
+inline Float4 Sub(Float4 a, Float4 b) { return Float4{vsubq_f32(a.v, b.v)}; }
+inline Float4 Mul(Float4 a, Float4 b) { return Float4{vmulq_f32(a.v, b.v)}; }
+inline Float4 Min(Float4 a, Float4 b) { return Float4{vminq_f32(a.v, b.v)}; }
+inline Float4 Max(Float4 a, Float4 b) { return Float4{vmaxq_f32(a.v, b.v)}; }
+
+#if defined(__aarch64__)
+inline Float4 Div(Float4 a, Float4 b) { return Float4{vdivq_f32(a.v, b.v)}; }
+inline Float4 Sqrt(Float4 a) { return Float4{vsqrtq_f32(a.v)}; }
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Float4{vfmaq_f32(c.v, a.v, b.v)}; }
+#else
+inline Float4 Div(Float4 a, Float4 b) {
+    float32x4_t r = vrecpeq_f32(b.v);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    return Float4{vmulq_f32(a.v, r)};
+}
+inline Float4 Sqrt(Float4 a) {
+    float values[4];
+    vst1q_f32(values, a.v);
+    for (float& value : values) {
+        value = std::sqrt(value);
+    }
+    return Float4{vld1q_f32(values)};
+}
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Float4{vmlaq_f32(c.v, a.v, b.v)}; }
+#endif
+
+template <int N>
+inline Float4 SplatLane(Float4 a) {
+    return Float4{vdupq_n_f32(vgetq_lane_f32(a.v, N))};
+}
+
+inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    const float32x4x2_t t01 = vtrnq_f32(r0.v, r1.v);
+    const float32x4x2_t t23 = vtrnq_f32(r2.v, r3.v);
+    r0.v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1.v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2.v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3.v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+struct Mask4 {
+    uint32x4_t v;
+};
+
+inline Mask4 CmpGt(Float4 a, Float4 b) { return Mask4{vcgtq_f32(a.v, b.v)}; }
+inline Mask4 CmpLt(Float4 a, Float4 b) { return Mask4{vcltq_f32(a.v, b.v)}; }
+inline Mask4 And(Mask4 a, Mask4 b) { return Mask4{vandq_u32(a.v, b.v)}; }
+inline Mask4 Or(Mask4 a, Mask4 b) { return Mask4{vorrq_u32(a.v, b.v)}; }
+inline int MoveMask(Mask4 m) {
+    return static_cast<int>((vgetq_lane_u32(m.v, 0) & 1u) | ((vgetq_lane_u32(m.v, 1) & 1u) << 1) |
+                            ((vgetq_lane_u32(m.v, 2) & 1u) << 2) | ((vgetq_lane_u32(m.v, 3) & 1u) << 3));
+}
+
+inline Float4 Select(Mask4 mask, Float4 a, Float4 b) { return Float4{vbslq_f32(mask.v, a.v, b.v)}; }
+
+#else
+
+// Portable fallback. Kept as a plain array so the optimizer can still auto-vectorize it.
+struct Float4 {
+    float v[4];
+};
+
+inline Float4 Load(const float* p) { return Float4{{p[0], p[1], p[2], p[3]}}; }
+inline void Store(float* p, Float4 a) {
+    p[0] = a.v[0];
+    p[1] = a.v[1];
+    p[2] = a.v[2];
+    p[3] = a.v[3];
+}
+inline Float4 Splat(float s) { return Float4{{s, s, s, s}}; }
+inline Float4 Set(float x, float y, float z, float w) { return Float4{{x, y, z, w}}; }
+
+#define OW_SIMD_SCALAR_BINARY(name, expr)                  \
+    inline Float4 name(Float4 a, Float4 b) {               \
+        Float4 r{};                                        \
+        for (int i = 0; i < 4; ++i) {                      \
+            const float x = a.v[i];                        \
+            const float y = b.v[i];                        \
+            r.v[i] = (expr);                               \
+        }                                                  \
+        return r;                                          \
+    }
+
+OW_SIMD_SCALAR_BINARY(Add, x + y)
+OW_SIMD_SCALAR_BINARY(Sub, x - y)
+OW_SIMD_SCALAR_BINARY(Mul, x * y)
+OW_SIMD_SCALAR_BINARY(Div, x / y)
+OW_SIMD_SCALAR_BINARY(Min, x < y ? x : y)
+OW_SIMD_SCALAR_BINARY(Max, x > y ? x : y)
+
+#undef OW_SIMD_SCALAR_BINARY
+
+inline Float4 Sqrt(Float4 a) {
+    Float4 r{};
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = std::sqrt(a.v[i]);
+    }
+    return r;
+}
+
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+    Float4 r{};
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = a.v[i] * b.v[i] + c.v[i];
+    }
+    return r;
+}
+
+template <int N>
+inline Float4 SplatLane(Float4 a) {
+    return Splat(a.v[N]);
+}
+
+inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    const Float4 c0{{r0.v[0], r1.v[0], r2.v[0], r3.v[0]}};
+    const Float4 c1{{r0.v[1], r1.v[1], r2.v[1], r3.v[1]}};
+    const Float4 c2{{r0.v[2], r1.v[2], r2.v[2], r3.v[2]}};
+    const Float4 c3{{r0.v[3], r1.v[3], r2.v[3], r3.v[3]}};
+    r0 = c0;
+    r1 = c1;
+    r2 = c2;
+    r3 = c3;
+}
+
+struct Mask4 {
+    bool v[4];
+};
+
+inline Mask4 CmpGt(Float4 a, Float4 b) { return Mask4{{a.v[0] > b.v[0], a.v[1] > b.v[1], a.v[2] > b.v[2], a.v[3] > b.v[3]}}; }
+inline Mask4 CmpLt(Float4 a, Float4 b) { return Mask4{{a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3]}}; }
+inline Mask4 And(Mask4 a, Mask4 b) { return Mask4{{a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3]}}; }
+inline Mask4 Or(Mask4 a, Mask4 b) { return Mask4{{a.v[0] || b.v[0], a.v[1] || b.v[1], a.v[2] || b.v[2], a.v[3] || b.v[3]}}; }
+inline int MoveMask(Mask4 m) { return (m.v[0] ? 1 : 0) | (m.v[1] ? 2 : 0) | (m.v[2] ? 4 : 0) | (m.v[3] ? 8 : 0); }
+
+inline Float4 Select(Mask4 mask, Float4 a, Float4 b) {
+    Float4 r{};
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+
+#endif
+
+// 8-wide lane group. Native __m256 under AVX2, otherwise a pair of Float4 so the same
+// stream code compiles (and still vectorizes) on every backend.
+#if defined(OW_SIMD_AVX2)
+
+struct Float8 {
+    __m256 v;
+};
+
+struct Mask8 {
+    __m256 v;
+};
+
+inline Float8 Load8(const float* p) { return Float8{_mm256_loadu_ps(p)}; }
+inline void Store(float* p, Float8 a) { _mm256_storeu_ps(p, a.v); }
+inline Float8 Splat8(float s) { return Float8{_mm256_set1_ps(s)}; }
+inline Float8 Add(Float8 a, Float8 b) { return Float8{_mm256_add_ps(a.v, b.v)}; }
+inline Float8 Sub(Float8 a, Float8 b) { return Float8{_mm256_sub_ps(a.v, b.v)}; }
+inline Float8 Mul(Float8 a, Float8 b) { return Float8{_mm256_mul_ps(a.v, b.v)}; }
+inline Float8 Div(Float8 a, Float8 b) { return Float8{_mm256_div_ps(a.v, b.v)}; }
+inline Float8 Min(Float8 a, Float8 b) { return Float8{_mm256_min_ps(a.v, b.v)}; }
+inline Float8 Max(Float8 a, Float8 b) { return Float8{_mm256_max_ps(a.v, b.v)}; }
+inline Float8 Sqrt(Float8 a) { return Float8{_mm256_sqrt_ps(a.v)}; }
+inline Float8 MulAdd(Float8 a, Float8 b, Float8 c) { return Float8{_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+
+inline Mask8 CmpGt(Float8 a, Float8 b) { return Mask8{_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline Mask8 CmpLt(Float8 a, Float8 b) { return Mask8{_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline Mask8 And(Mask8 a, Mask8 b) { return Mask8{_mm256_and_ps(a.v, b.v)}; }
+inline Mask8 Or(Mask8 a, Mask8 b) { return Mask8{_mm256_or_ps(a.v, b.v)}; }
+inline int MoveMask(Mask8 m) { return _mm256_movemask_ps(m.v); }
+inline Float8 Select(Mask8 mask, Float8 a, Float8 b) { return Float8{_mm256_blendv_ps(b.v, a.v, mask.v)}; }
+
+#else
+
+struct Float8 {
+    Float4 lo;
+    Float4 hi;
+};
+
+struct Mask8 {
+    Mask4 lo;
+    Mask4 hi;
+};
+
+inline Float8 Load8(const float* p) { return Float8{Load(p), Load(p + 4)}; }
+inline void Store(float* p, Float8 a) {
+    Store(p, a.lo);
+    Store(p + 4, a.hi);
+}
+inline Float8 Splat8(float s) { return Float8{Splat(s), Splat(s)}; }
+inline Float8 Add(Float8 a, Float8 b) { return Float8{Add(a.lo, b.lo), Add(a.hi, b.hi)}; }
+inline Float8 Sub(Float8 a, Float8 b) { return Float8{Sub(a.lo, b.lo), Sub(a.hi, b.hi)}; }
+inline Float8 Mul(Float8 a, Float8 b) { return Float8{Mul(a.lo, b.lo), Mul(a.hi, b.hi)}; }
+inline Float8 Div(Float8 a, Float8 b) { return Float8{Div(a.lo, b.lo), Div(a.hi, b.hi)}; }
+inline Float8 Min(Float8 a, Float8 b) { return Float8{Min(a.lo, b.lo), Min(a.hi, b.hi)}; }
+inline Float8 Max(Float8 a, Float8 b) { return Float8{Max(a.lo, b.lo), Max(a.hi, b.hi)}; }
+inline Float8 Sqrt(Float8 a) { return Float8{Sqrt(a.lo), Sqrt(a.hi)}; }
+inline Float8 MulAdd(Float8 a, Float8 b, Float8 c) { return Float8{MulAdd(a.lo, b.lo, c.lo), MulAdd(a.hi, b.hi, c.hi)}; }
+
+inline Mask8 CmpGt(Float8 a, Float8 b) { return Mask8{CmpGt(a.lo, b.lo), CmpGt(a.hi, b.hi)}; }
+inline Mask8 CmpLt(Float8 a, Float8 b) { return Mask8{CmpLt(a.lo, b.lo), CmpLt(a.hi, b.hi)}; }
+inline Mask8 And(Mask8 a, Mask8 b) { return Mask8{And(a.lo, b.lo), And(a.hi, b.hi)}; }
+inline Mask8 Or(Mask8 a, Mask8 b) { return Mask8{Or(a.lo, b.lo), Or(a.hi, b.hi)}; }
+inline int MoveMask(Mask8 m) { return MoveMask(m.lo) | (MoveMask(m.hi) << 4); }
+inline Float8 Select(Mask8 mask, Float8 a, Float8 b) { return Float8{Select(mask.lo, a.lo, b.lo), Select(mask.hi, a.hi, b.hi)}; }
+
+#endif
+
+} // namespace ow::simd
@@ -2,23 +2,77 @@
 
 // Core transform module: position, rotation and scale composition for scene entities.
 
+#include <cstdint>
+
 #include "Engine/Core/Math.hpp"
 
 namespace ow {
 
-struct Transform {
-    Vec3 position{0.0f, 0.0f, 0.0f};
-    Vec3 rotationEuler{0.0f, 0.0f, 0.0f};
-    Vec3 scale{1.0f, 1.0f, 1.0f};
+// Rotation is stored as a quaternion. The local matrix is cached and rebuilt lazily only
+// after one of the setters changed a component, so unmoved entities cost nothing per frame.
+class Transform {
+public:
+    const Vec3& Position() const { return position_; }
+    const Quat& Rotation() const { return rotation_; }
+    const Vec3& Scale() const { return scale_; }
+
+    void SetPosition(const Vec3& position) {
+        position_ = position;
+        MarkDirty();
+    }
+
+    void Translate(const Vec3& delta) {
+        position_ += delta;
+        MarkDirty();
+    }
+
+    void SetRotation(const Quat& rotation) {
+        rotation_ = Normalize(rotation);
+        MarkDirty();
+    }
 
-    Mat4 Matrix() const {
-        const Mat4 t = Mat4::Translation(position);
-        const Mat4 rx = Mat4::RotationX(rotationEuler.x);
-        const Mat4 ry = Mat4::RotationY(rotationEuler.y);
-        const Mat4 rz = Mat4::RotationZ(rotationEuler.z);
-        const Mat4 s = Mat4::Scale(scale);
-        return t * rz * ry * rx * s;
+    // Euler angles in radians, applied X then Y then Z.
+    void SetRotationEuler(const Vec3& radians) {
+        rotation_ = Quat::FromEuler(radians);
+        MarkDirty();
     }
+
+    void Rotate(const Quat& delta) {
+        rotation_ = Normalize(delta * rotation_);
+        MarkDirty();
+    }
+
+    void SetScale(const Vec3& scale) {
+        scale_ = scale;
+        MarkDirty();
+    }
+
+    const Mat4& Matrix() const {
+        if (dirty_) {
+            matrix_ = Mat4::TRS(position_, rotation_, scale_);
+            dirty_ = false;
+        }
+        return matrix_;
+    }
+
+    // Incremented on every change; lets dependents detect updates without a flag reset.
+    std::uint32_t Version() const { return version_; }
+
+private:
+    void MarkDirty() {
+        dirty_ = true;
+        ++version_;
+    }
+
+    // Version and flag first: change detection scans only touch the leading cache line.
+    std::uint32_t version_ = 0;
+    mutable bool dirty_ = false;
+
+    Vec3 position_{0.0f, 0.0f, 0.0f};
+    Quat rotation_{};
+    Vec3 scale_{1.0f, 1.0f, 1.0f};
+
+    mutable Mat4 matrix_ = Mat4::Identity();
 };
 
 } // namespace ow
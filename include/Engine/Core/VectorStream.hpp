@@ -0,0 +1,161 @@
+#pragma once
+
+// Core stream module: structure-of-arrays vector types for batched (4/8 lanes at a time) math.
+
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Core/Math.hpp"
+#include "Engine/Core/Simd.hpp"
+
+namespace ow {
+
+struct Vec3x4 {
+    simd::Float4 x;
+    simd::Float4 y;
+    simd::Float4 z;
+};
+
+struct Vec3x8 {
+    simd::Float8 x;
+    simd::Float8 y;
+    simd::Float8 z;
+};
+
+inline Vec3x4 Splat4(const Vec3& v) { return Vec3x4{simd::Splat(v.x), simd::Splat(v.y), simd::Splat(v.z)}; }
+inline Vec3x8 Splat8(const Vec3& v) { return Vec3x8{simd::Splat8(v.x), simd::Splat8(v.y), simd::Splat8(v.z)}; }
+
+inline Vec3x4 Add(const Vec3x4& a, const Vec3x4& b) { return Vec3x4{simd::Add(a.x, b.x), simd::Add(a.y, b.y), simd::Add(a.z, b.z)}; }
+inline Vec3x4 Sub(const Vec3x4& a, const Vec3x4& b) { return Vec3x4{simd::Sub(a.x, b.x), simd::Sub(a.y, b.y), simd::Sub(a.z, b.z)}; }
+inline Vec3x4 Scale(const Vec3x4& a, simd::Float4 s) { return Vec3x4{simd::Mul(a.x, s), simd::Mul(a.y, s), simd::Mul(a.z, s)}; }
+
+// Returns a * s + c.
+inline Vec3x4 MulAdd(const Vec3x4& a, simd::Float4 s, const Vec3x4& c) {
+    return Vec3x4{simd::MulAdd(a.x, s, c.x), simd::MulAdd(a.y, s, c.y), simd::MulAdd(a.z, s, c.z)};
+}
+
+inline simd::Float4 Dot(const Vec3x4& a, const Vec3x4& b) {
+    return simd::MulAdd(a.z, b.z, simd::MulAdd(a.y, b.y, simd::Mul(a.x, b.x)));
+}
+
+inline simd::Float4 Length(const Vec3x4& a) { return simd::Sqrt(Dot(a, a)); }
+
+inline Vec3x8 Add(const Vec3x8& a, const Vec3x8& b) { return Vec3x8{simd::Add(a.x, b.x), simd::Add(a.y, b.y), simd::Add(a.z, b.z)}; }
+inline Vec3x8 Sub(const Vec3x8& a, const Vec3x8& b) { return Vec3x8{simd::Sub(a.x, b.x), simd::Sub(a.y, b.y), simd::Sub(a.z, b.z)}; }
+inline Vec3x8 Scale(const Vec3x8& a, simd::Float8 s) { return Vec3x8{simd::Mul(a.x, s), simd::Mul(a.y, s), simd::Mul(a.z, s)}; }
+
+// Returns a * s + c.
+inline Vec3x8 MulAdd(const Vec3x8& a, simd::Float8 s, const Vec3x8& c) {
+    return Vec3x8{simd::MulAdd(a.x, s, c.x), simd::MulAdd(a.y, s, c.y), simd::MulAdd(a.z, s, c.z)};
+}
+
+inline simd::Float8 Dot(const Vec3x8& a, const Vec3x8& b) {
+    return simd::MulAdd(a.z, b.z, simd::MulAdd(a.y, b.y, simd::Mul(a.x, b.x)));
+}
+
+inline simd::Float8 Length(const Vec3x8& a) { return simd::Sqrt(Dot(a, a)); }
+
+// Matches scalar Normalize(): lanes shorter than 1e-5 come back as zero vectors.
+inline Vec3x4 Normalize(const Vec3x4& a) {
+    const simd::Float4 len = Length(a);
+    const simd::Mask4 valid = simd::CmpGt(len, simd::Splat(0.00001f));
+    const simd::Float4 inv = simd::Select(valid, simd::Div(simd::Splat(1.0f), simd::Max(len, simd::Splat(0.00001f))), simd::Splat(0.0f));
+    return Scale(a, inv);
+}
+
+inline Vec3x8 Normalize(const Vec3x8& a) {
+    const simd::Float8 len = Length(a);
+    const simd::Mask8 valid = simd::CmpGt(len, simd::Splat8(0.00001f));
+    const simd::Float8 inv = simd::Select(valid, simd::Div(simd::Splat8(1.0f), simd::Max(len, simd::Splat8(0.00001f))), simd::Splat8(0.0f));
+    return Scale(a, inv);
+}
+
+// Contiguous float array padded to a multiple of kLanes so kernels never need a scalar tail.
+class FloatStream {
+public:
+    static constexpr std::size_t kLanes = 8;
+
+    void Resize(std::size_t count, float fill = 0.0f) {
+        count_ = count;
+        data_.assign(PaddedSize(count), fill);
+    }
+
+    std::size_t Size() const { return count_; }
+    std::size_t PaddedSize() const { return data_.size(); }
+
+    float* Data() { return data_.data(); }
+    const float* Data() const { return data_.data(); }
+
+    float& operator[](std::size_t index) { return data_[index]; }
+    float operator[](std::size_t index) const { return data_[index]; }
+
+    simd::Float4 Load4(std::size_t index) const { return simd::Load(data_.data() + index); }
+    simd::Float8 Load8(std::size_t index) const { return simd::Load8(data_.data() + index); }
+    void Store(std::size_t index, simd::Float4 value) { simd::Store(data_.data() + index, value); }
+    void Store(std::size_t index, simd::Float8 value) { simd::Store(data_.data() + index, value); }
+
+    static std::size_t PaddedSize(std::size_t count) { return (count + kLanes - 1) / kLanes * kLanes; }
+
+private:
+    std::vector<float> data_;
+    std::size_t count_ = 0;
+};
+
+// SoA storage for Vec3 values: three FloatStreams that load/store as Vec3x4/Vec3x8.
+class Vec3Stream {
+public:
+    static constexpr std::size_t kLanes = FloatStream::kLanes;
+
+    void Resize(std::size_t count) {
+        x.Resize(count);
+        y.Resize(count);
+        z.Resize(count);
+    }
+
+    std::size_t Size() const { return x.Size(); }
+    std::size_t PaddedSize() const { return x.PaddedSize(); }
+
+    void Set(std::size_t index, const Vec3& v) {
+        x[index] = v.x;
+        y[index] = v.y;
+        z[index] = v.z;
+    }
+
+    Vec3 Get(std::size_t index) const { return Vec3{x[index], y[index], z[index]}; }
+
+    Vec3x4 Load4(std::size_t index) const { return Vec3x4{x.Load4(index), y.Load4(index), z.Load4(index)}; }
+    Vec3x8 Load8(std::size_t index) const { return Vec3x8{x.Load8(index), y.Load8(index), z.Load8(index)}; }
+
+    void Store(std::size_t index, const Vec3x4& v) {
+        x.Store(index, v.x);
+        y.Store(index, v.y);
+        z.Store(index, v.z);
+    }
+
+    void Store(std::size_t index, const Vec3x8& v) {
+        x.Store(index, v.x);
+        y.Store(index, v.y);
+        z.Store(index, v.z);
+    }
+
+    // AoS <-> SoA conversion.
+    void Assign(const std::vector<Vec3>& values) {
+        Resize(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            Set(i, values[i]);
+        }
+    }
+
+    void CopyTo(std::vector<Vec3>& out) const {
+        out.resize(Size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = Get(i);
+        }
+    }
+
+    FloatStream x;
+    FloatStream y;
+    FloatStream z;
+};
+
+} // namespace ow
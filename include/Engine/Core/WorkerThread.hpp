@@ -0,0 +1,40 @@
+#pragma once
+
+// Core worker thread module: one long-lived thread that runs posted tasks one at a time.
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ow {
+
+// Starts its thread once and sleeps between tasks, so per-frame work can be moved off the
+// calling thread without creating a thread per frame. One task is in flight at a time.
+class WorkerThread {
+public:
+    WorkerThread();
+    // Waits for the current task, then joins the thread.
+    ~WorkerThread();
+
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    // Hands task to the thread; waits first if the previous one has not finished.
+    void Post(std::function<void()> task);
+    // Returns once the posted task (if any) has finished.
+    void Wait();
+
+private:
+    void Loop();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void()> task_;
+    bool busy_ = false;
+    bool stopping_ = false;
+};
+
+} // namespace ow
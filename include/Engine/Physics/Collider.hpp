@@ -0,0 +1,11 @@
+#pragma once
+
+// Physics module: sphere collider shape used by the physics solver.
+
+namespace ow {
+
+struct Collider {
+    float radius = 0.5f;
+};
+
+} // namespace ow
@@ -0,0 +1,43 @@
+#pragma once
+
+// Renderer dynamic resolution module: internal render scale driven by measured frame cost.
+
+#include "Engine/UI/DebugUI.hpp"
+
+namespace ow {
+
+// Picks RenderSettings::resolutionScale for ResolutionMode::Dynamic. The scale drops as
+// soon as the smoothed frame cost stays above the budget for a few frames, and climbs
+// back one step at a time only after a long run well under it; between the two
+// thresholds it holds, so the image does not pump. After every change the controller
+// waits for measurements taken at the new scale (GPU timings arrive frames late).
+class DynamicResolution {
+public:
+    explicit DynamicResolution(float budgetMs = 1000.0f / 60.0f) : budgetMs_(budgetMs) {}
+
+    void SetBudget(float budgetMs) { budgetMs_ = budgetMs; }
+    float Budget() const { return budgetMs_; }
+    void SetRange(float minScale, float maxScale);
+
+    // One frame's measurements: CPU time spent building the frame (not waiting for the
+    // swap) and the newest resolved GPU frame time, or 0 while none is known. The GPU
+    // time drives the scale when available, since CPU cost does not shrink with it.
+    void Update(float cpuMs, float gpuMs);
+    // Back to full scale with no history, e.g. when the mode is switched off.
+    void Reset();
+
+    float Scale() const { return scale_; }
+    DynamicResolutionStats Stats() const;
+
+private:
+    float budgetMs_;
+    float minScale_ = 0.5f;
+    float maxScale_ = 1.0f;
+    float scale_ = 1.0f;
+    float costMs_ = 0.0f;
+    int overFrames_ = 0;
+    int underFrames_ = 0;
+    int settleFrames_ = 0;
+};
+
+} // namespace ow
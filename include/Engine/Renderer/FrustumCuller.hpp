@@ -0,0 +1,31 @@
+#pragma once
+
+// Renderer culling module: batched sphere-vs-frustum visibility test over SoA bounds.
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Bounds.hpp"
+#include "Engine/Core/VectorStream.hpp"
+
+namespace ow {
+
+// Fill world-space spheres with Reset/Set, then Cull tests 8 spheres against all six
+// planes per iteration and returns the indices that survive.
+class FrustumCuller {
+public:
+    void Reset(std::size_t count);
+    void Set(std::size_t index, const BoundingSphere& sphere);
+
+    // Appends surviving indices (in input order) to visible.
+    void Cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const;
+    // Same over [begin, end); begin must be a multiple of Vec3Stream::kLanes. Disjoint
+    // ranges may be culled concurrently into separate vectors.
+    void Cull(const Frustum& frustum, std::size_t begin, std::size_t end, std::vector<std::uint32_t>& visible) const;
+
+private:
+    Vec3Stream centers_;
+    FloatStream radii_;
+};
+
+} // namespace ow
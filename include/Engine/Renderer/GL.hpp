@@ -8,3 +8,22 @@
 
 #include <SDL_opengl.h>
 #include <SDL_opengl_glext.h>
+
+#include <cstring>
+
+namespace ow {
+
+// Linear scan of the current context's extension list; callers cache the answer.
+inline bool HasGLExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension != nullptr && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ow
@@ -0,0 +1,106 @@
+#pragma once
+
+// Renderer profiling module: GPU pass timings from timestamp queries, read back frames late.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "Engine/UI/DebugUI.hpp"
+
+namespace ow {
+
+// Each scope brackets its GL commands with two GL_TIMESTAMP queries (timestamps, unlike
+// GL_TIME_ELAPSED, allow nesting). Queries live in a ring of kFrameLatency frames; a
+// frame's results are read when its slot comes round again, and only if the GPU has
+// already produced them, so the profiler never waits on the pipeline.
+class GpuProfiler {
+public:
+    static constexpr int kFrameLatency = 4;
+    static constexpr std::size_t kHistoryFrames = 600;
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool Enabled() const { return enabled_; }
+
+    void BeginFrame();
+    void EndFrame();
+
+    // name must outlive the frame's readback (string literals in practice).
+    void BeginScope(const char* name);
+    void EndScope();
+
+    // Latest resolved frame, in scope begin order, with a smoothed average per scope.
+    const std::vector<GpuTiming>& Timings() const { return timings_; }
+    // Frames whose queries were not ready when their slot was reused.
+    int DroppedFrames() const { return dropped_; }
+
+    // Writes every frame in the history as "frame,scope,depth,ms" rows.
+    bool ExportCsv(const std::string& path) const;
+
+private:
+    struct Scope {
+        const char* name = nullptr;
+        int depth = 0;
+        unsigned int begin = 0;
+        unsigned int end = 0;
+    };
+
+    struct FrameSlot {
+        std::vector<Scope> scopes;
+        std::vector<unsigned int> pool;
+        std::size_t poolUsed = 0;
+        std::uint64_t frame = 0;
+        bool pending = false;
+    };
+
+    unsigned int AcquireQuery(FrameSlot& slot);
+    void Resolve(FrameSlot& slot);
+
+    struct HistoryEntry {
+        std::uint64_t frame = 0;
+        std::vector<GpuTiming> timings;
+    };
+
+    FrameSlot slots_[kFrameLatency];
+    int current_ = -1;
+    std::uint64_t frameIndex_ = 0;
+    int depth_ = 0;
+    std::vector<int> openScopes_;
+    bool enabled_ = true;
+    bool inFrame_ = false;
+    int dropped_ = 0;
+
+    std::vector<GpuTiming> timings_;
+    std::deque<HistoryEntry> history_;
+};
+
+// Brackets the enclosing block with a profiler scope; a null profiler is a no-op.
+class GpuScope {
+public:
+    GpuScope(GpuProfiler* profiler, const char* name) : profiler_(profiler) {
+        if (profiler_) {
+            profiler_->BeginScope(name);
+        }
+    }
+    ~GpuScope() {
+        if (profiler_) {
+            profiler_->EndScope();
+        }
+    }
+
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+    GpuProfiler* profiler_;
+};
+
+} // namespace ow
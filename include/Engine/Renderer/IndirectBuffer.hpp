@@ -0,0 +1,46 @@
+#pragma once
+
+// Renderer indirect module: GL 4.3 multi-draw indirect command stream.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ow {
+
+// Layout fixed by GL for glMultiDrawElementsIndirect. firstIndex counts indices, not bytes.
+struct DrawElementsIndirectCommand {
+    std::uint32_t count = 0;
+    std::uint32_t instanceCount = 0;
+    std::uint32_t firstIndex = 0;
+    std::int32_t baseVertex = 0;
+    std::uint32_t baseInstance = 0;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "indirect command layout must match GL");
+
+// Orphaned and refilled once per frame like InstanceBuffer. Commands select their
+// instance range through baseInstance, which offsets every divisor-1 attribute, so the
+// instance attributes are pointed at the start of the buffer once per VAO.
+class IndirectBuffer {
+public:
+    IndirectBuffer() = default;
+    ~IndirectBuffer();
+
+    IndirectBuffer(const IndirectBuffer&) = delete;
+    IndirectBuffer& operator=(const IndirectBuffer&) = delete;
+
+    // True when the current context has glMultiDrawElementsIndirect with base instance
+    // (GL 4.3, or the ARB extensions). Needs a current context.
+    static bool Supported();
+
+    void Upload(const std::vector<DrawElementsIndirectCommand>& commands);
+    // Binds GL_DRAW_INDIRECT_BUFFER and submits count commands starting at first.
+    void Draw(unsigned int indexType, std::size_t first, std::size_t count) const;
+
+private:
+    unsigned int buffer_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace ow
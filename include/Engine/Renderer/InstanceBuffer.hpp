@@ -0,0 +1,43 @@
+#pragma once
+
+// Renderer instancing module: streamed per-instance transforms fed as vertex attributes.
+
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Core/Math.hpp"
+
+namespace ow {
+
+// Attribute locations used by the standard shader: a mat4 takes four consecutive
+// locations, a mat3 three.
+enum InstanceAttribute : unsigned int {
+    kInstanceModelLocation = 3,
+    kInstanceNormalLocation = 7,
+};
+
+struct InstanceData {
+    Mat4 model;
+    Mat3 normalMatrix;
+};
+
+// Orphaned and refilled once per frame. Bind points the instance attributes of the
+// currently bound VAO at a range of the buffer; GL 3.3 has no base-instance draws, so
+// each instanced group re-points the attributes at its first instance.
+class InstanceBuffer {
+public:
+    InstanceBuffer() = default;
+    ~InstanceBuffer();
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    void Upload(const std::vector<InstanceData>& instances);
+    void Bind(std::size_t firstInstance) const;
+
+private:
+    unsigned int buffer_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace ow
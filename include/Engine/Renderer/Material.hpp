@@ -9,10 +9,14 @@
 namespace ow {
 
 class Shader;
+class ShaderVariants;
 
 class Material {
 public:
     std::shared_ptr<Shader> shader;
+    // When set, the renderer draws with the variant matching this material's textures and
+    // the frame's PS2 setting instead of shader.
+    std::shared_ptr<ShaderVariants> shaderVariants;
 
     // Base surface response.
     Vec3 color{0.8f, 0.8f, 0.8f};
@@ -1,24 +1,33 @@
 #pragma once
 
-// Renderer mesh module: stores vertex/index buffers and draws geometry.
+// Renderer mesh module: geometry handle into the shared mesh arena, plus bounds.
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "Engine/Core/Bounds.hpp"
 #include "Engine/Core/Math.hpp"
+#include "Engine/Renderer/MeshArena.hpp"
+#include "Engine/Renderer/VertexFormat.hpp"
 
 namespace ow {
 
-struct Vertex {
-    Vec3 position;
-    Vec3 normal;
-    Vec2 uv;
+class Mesh;
+
+// A coarser stand-in for a mesh (see MeshSimplifier::BuildLods).
+struct MeshLod {
+    std::shared_ptr<Mesh> mesh;
+    // Largest distance from a simplified vertex to the original triangle planes it
+    // replaced, in mesh-space units (see SimplifyResult::error).
+    float error = 0.0f;
 };
 
 class Mesh {
 public:
     Mesh() = default;
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+         VertexFormat format = DefaultFormat());
     ~Mesh();
 
     Mesh(const Mesh&) = delete;
@@ -27,18 +36,55 @@ public:
     Mesh(Mesh&& other) noexcept;
     Mesh& operator=(Mesh&& other) noexcept;
 
+    // Binds the arena VAO, draws and unbinds. Renderer binds through its state tracker instead.
     void Draw() const;
 
+    // CPU copy of the uploaded geometry, kept for static batching and mesh processing.
+    const std::vector<Vertex>& Vertices() const { return vertices_; }
+    const std::vector<unsigned int>& Indices() const { return indices_; }
+
+    // Every mesh of a format shares its arena VAO; draws select geometry by index offset and base vertex.
+    unsigned int VertexArray() const { return MeshArena::Shared(format_).VertexArray(); }
+    const MeshAllocation& Allocation() const { return allocation_; }
+    int IndexCount() const { return static_cast<int>(allocation_.indexCount); }
+    // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, picked at upload from the vertex count.
+    unsigned int IndexType() const;
+
+    VertexFormat Format() const { return format_; }
+    // Maps decoded attribute positions back to mesh space: identity for Float, and the
+    // bounds center/extents for Packed (whose snorm16 positions are bounds-relative).
+    Mat4 DecodeMatrix() const;
+
+    // Format used by meshes constructed without an explicit one (Float by default).
+    static void SetDefaultFormat(VertexFormat format) { defaultFormat_ = format; }
+    static VertexFormat DefaultFormat() { return defaultFormat_; }
+
+    // Local-space bounds computed from the vertices at upload time.
+    const Aabb& LocalBounds() const { return bounds_; }
+    const BoundingSphere& LocalSphere() const { return sphere_; }
+
+    // Coarser levels, finest first; the renderer picks one by projected error.
+    void SetLods(std::vector<MeshLod> lods) { lods_ = std::move(lods); }
+    const std::vector<MeshLod>& Lods() const { return lods_; }
+
     static std::shared_ptr<Mesh> CreateCube(float halfExtent = 0.5f);
 
 private:
     void Upload(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void ComputeBounds(const std::vector<Vertex>& vertices);
     void Release();
 
-    unsigned int vao_ = 0;
-    unsigned int vbo_ = 0;
-    unsigned int ebo_ = 0;
-    int indexCount_ = 0;
+    static inline VertexFormat defaultFormat_ = VertexFormat::Float;
+
+    MeshAllocation allocation_{};
+    VertexFormat format_ = VertexFormat::Float;
+
+    Aabb bounds_{};
+    BoundingSphere sphere_{};
+
+    std::vector<Vertex> vertices_;
+    std::vector<unsigned int> indices_;
+    std::vector<MeshLod> lods_;
 };
 
 } // namespace ow
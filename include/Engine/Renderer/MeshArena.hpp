@@ -0,0 +1,99 @@
+#pragma once
+
+// Renderer mesh arena module: sub-allocates mesh geometry out of shared vertex/index buffers.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "Engine/Renderer/VertexFormat.hpp"
+
+namespace ow {
+
+// First-fit allocator over an abstract [0, capacity) range. Free blocks are kept sorted
+// by offset so neighbours coalesce on Free.
+class FreeListAllocator {
+public:
+    static constexpr std::size_t kInvalid = static_cast<std::size_t>(-1);
+
+    void Reset(std::size_t capacity);
+    // Extends the range; the new tail merges with a free block ending at the old capacity.
+    void Grow(std::size_t capacity);
+
+    // Returns kInvalid when no free block is large enough.
+    std::size_t Allocate(std::size_t size, std::size_t alignment = 1);
+    void Free(std::size_t offset, std::size_t size);
+
+    std::size_t Capacity() const { return capacity_; }
+    std::size_t Used() const { return used_; }
+
+private:
+    void Insert(std::size_t offset, std::size_t size);
+
+    std::map<std::size_t, std::size_t> free_;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+};
+
+// Where a mesh lives in the arena. Indices are relative to baseVertex, so the same index
+// data works wherever the vertices land.
+struct MeshAllocation {
+    std::int32_t baseVertex = 0;
+    std::uint32_t vertexCount = 0;
+    // Byte offset into the index buffer.
+    std::size_t indexOffset = 0;
+    std::uint32_t indexCount = 0;
+    // 2 (GL_UNSIGNED_SHORT) when the mesh has fewer than 65536 vertices, else 4.
+    std::uint8_t indexSize = 4;
+
+    bool IsValid() const { return vertexCount > 0; }
+};
+
+// One VAO over one vertex and one index buffer shared by every mesh of a vertex format,
+// so switching meshes is a change of draw offsets rather than of GL objects. Buffers
+// double in size (with a GPU-side copy) when full. 16- and 32-bit index ranges share the
+// index buffer. GL objects are created on first use and need a current context.
+class MeshArena {
+public:
+    static MeshArena& Shared(VertexFormat format);
+    // Shuts down both shared arenas. Call before the context is destroyed, after every
+    // Mesh has been; the statics themselves outlive the context.
+    static void ShutdownShared();
+
+    explicit MeshArena(VertexFormat format) : format_(format) {}
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // Deletes the GL objects and forgets every allocation; the arena re-creates them on
+    // the next Allocate. Needs the context that created them.
+    void Shutdown();
+
+    // vertices holds vertexCount elements laid out as VertexStride(Format()).
+    MeshAllocation Allocate(const void* vertices, std::size_t vertexCount, const std::vector<unsigned int>& indices);
+    void Free(const MeshAllocation& allocation);
+
+    VertexFormat Format() const { return format_; }
+    unsigned int VertexArray() const { return vao_; }
+
+    std::size_t VertexCapacity() const { return vertices_.Capacity(); }
+    std::size_t VerticesUsed() const { return vertices_.Used(); }
+    std::size_t IndexBytesUsed() const { return indexBytes_.Used(); }
+
+private:
+    void Init();
+    void GrowVertices(std::size_t minVertices);
+    void GrowIndices(std::size_t minBytes);
+    void SetupAttributes();
+
+    VertexFormat format_;
+    unsigned int vao_ = 0;
+    unsigned int vbo_ = 0;
+    unsigned int ebo_ = 0;
+    FreeListAllocator vertices_;
+    FreeListAllocator indexBytes_;
+};
+
+} // namespace ow
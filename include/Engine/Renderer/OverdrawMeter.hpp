@@ -0,0 +1,38 @@
+#pragma once
+
+// Renderer overdraw module: depth-tested fragments per pixel from occlusion queries.
+
+#include <cstdint>
+
+namespace ow {
+
+// Counts GL_SAMPLES_PASSED over the pass that first writes depth each frame, so the
+// figure is the number of fragments an ordinary depth-tested pass would shade per pixel.
+// Like GpuProfiler, queries rotate through kLatency slots and a slot's result is only
+// read once the GPU reports it available; a late result is skipped rather than waited on.
+class OverdrawMeter {
+public:
+    static constexpr int kLatency = 4;
+
+    OverdrawMeter() = default;
+    ~OverdrawMeter();
+
+    OverdrawMeter(const OverdrawMeter&) = delete;
+    OverdrawMeter& operator=(const OverdrawMeter&) = delete;
+
+    void Begin();
+    void End(int pixelCount);
+
+    // Smoothed fragments per pixel; 0 until the first result arrives.
+    float Overdraw() const { return overdraw_; }
+
+private:
+    unsigned int queries_[kLatency] = {};
+    std::int64_t pixels_[kLatency] = {};
+    bool pending_[kLatency] = {};
+    int slot_ = -1;
+    bool active_ = false;
+    float overdraw_ = 0.0f;
+};
+
+} // namespace ow
@@ -0,0 +1,71 @@
+#pragma once
+
+// Renderer post-process module: full-screen effect chain over the resolved scene.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/UI/DebugUI.hpp"
+
+namespace ow {
+
+class RenderTarget;
+
+// One stage of the chain. source defines `vec3 <function>(vec3 color, PostPixel p)` and
+// may read FrameBlock (see UniformBlocks.hpp). PostPixel carries:
+//   vec2 coord       scene pixel centre, in internal-resolution pixels
+//   float depth      window-space depth, 1.0 where nothing was drawn
+//   float viewDepth  distance along the view axis, as the scene shaders compute it
+//   bool background  true where nothing was drawn
+struct PostEffect {
+    std::string name;
+    std::string function;
+    std::string source;
+    // Null means always on.
+    std::function<bool(const RenderSettings&)> enabled;
+};
+
+// Every enabled effect runs in one fragment shader, in the order added, so each pixel
+// is read, stylized and written once no matter how many effects or how much overdraw
+// the scene had. The pass doubles as the upscale: it covers the present rectangle at
+// window resolution and fetches the scene texel under each pixel (nearest filtering).
+// One program is linked per combination of enabled effects, on first use.
+class PostProcessChain {
+public:
+    PostProcessChain();
+    ~PostProcessChain();
+
+    PostProcessChain(const PostProcessChain&) = delete;
+    PostProcessChain& operator=(const PostProcessChain&) = delete;
+
+    // At most 32 effects.
+    void Add(PostEffect effect);
+    // True if any effect is enabled for these settings.
+    bool Active(const RenderSettings& settings) const;
+
+    // Draws the scene's used region into (x, y, width, height) of the bound framebuffer.
+    // Expects FrameBlock bound; leaves depth testing enabled. False without a program.
+    bool Apply(const RenderTarget& scene, const RenderSettings& settings, int x, int y, int width, int height);
+
+private:
+    std::uint32_t EnabledMask(const RenderSettings& settings) const;
+    std::string FragmentSource(std::uint32_t mask) const;
+
+    std::vector<PostEffect> effects_;
+    struct Program {
+        // Null if the link failed, so the failure is reported once.
+        std::unique_ptr<Shader> shader;
+        UniformHandle presentOrigin;
+        UniformHandle presentSize;
+        UniformHandle sceneSize;
+    };
+    std::unordered_map<std::uint32_t, Program> programs_;
+    unsigned int vao_ = 0;
+};
+
+} // namespace ow
@@ -0,0 +1,41 @@
+#pragma once
+
+// Renderer program cache module: on-disk store of linked program binaries.
+
+#include <cstdint>
+#include <string>
+
+namespace ow {
+
+// Files are named by a 64-bit FNV-1a hash of both stage sources plus the GL vendor,
+// renderer and version strings, so a driver update or a source edit misses instead of
+// loading an incompatible binary. Needs GL 4.1 or ARB_get_program_binary; otherwise Open
+// fails and shaders always compile from source.
+class ProgramCache {
+public:
+    // Creates the directory when missing and reads the driver identity; needs a current context.
+    bool Open(const std::string& directory);
+    bool IsOpen() const { return open_; }
+
+    std::uint64_t Key(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    // Loads a cached binary into program; false on a miss or when the driver rejects it
+    // (the stale file is then removed). program is left unlinked on failure.
+    bool Load(std::uint64_t key, unsigned int program);
+    // Call after a successful link of a program created with the retrievable hint.
+    void Store(std::uint64_t key, unsigned int program);
+
+    int Hits() const { return hits_; }
+    int Misses() const { return misses_; }
+
+private:
+    std::string PathFor(std::uint64_t key) const;
+
+    std::string directory_;
+    std::string driver_;
+    bool open_ = false;
+    int hits_ = 0;
+    int misses_ = 0;
+};
+
+} // namespace ow
@@ -0,0 +1,73 @@
+#pragma once
+
+// Renderer queue module: sortable draw keys and an LSD radix sort over them.
+
+#include <cstdint>
+#include <vector>
+
+namespace ow {
+
+enum class RenderPass : std::uint8_t {
+    Opaque = 0,
+};
+
+// 64-bit key, most significant field first:
+//   pass:2 | shader:10 | material:14 | mesh:14 | depth:24
+// Sorting ascending groups draws by program, then material, then mesh so state changes
+// are minimal, and orders each group front to back. Ids too large for their field
+// saturate to its last value: those draws still sort after the others but may share a
+// key with unrelated draws, so a key match alone never means "same draw state".
+struct DrawKey {
+    static constexpr int kShaderBits = 10;
+    static constexpr int kMaterialBits = 14;
+    static constexpr int kMeshBits = 14;
+    static constexpr int kDepthBits = 24;
+
+    static constexpr std::uint32_t kMaxShader = (1u << kShaderBits) - 1u;
+    static constexpr std::uint32_t kMaxMaterial = (1u << kMaterialBits) - 1u;
+    static constexpr std::uint32_t kMaxMesh = (1u << kMeshBits) - 1u;
+
+    static std::uint64_t Make(RenderPass pass, std::uint32_t shader, std::uint32_t material, std::uint32_t mesh,
+                              std::uint32_t depth) {
+        const std::uint64_t kDepthMask = (1u << kDepthBits) - 1u;
+        return (static_cast<std::uint64_t>(pass) << 62) |
+               (static_cast<std::uint64_t>(shader < kMaxShader ? shader : kMaxShader)
+                << (kMaterialBits + kMeshBits + kDepthBits)) |
+               (static_cast<std::uint64_t>(material < kMaxMaterial ? material : kMaxMaterial) << (kMeshBits + kDepthBits)) |
+               (static_cast<std::uint64_t>(mesh < kMaxMesh ? mesh : kMaxMesh) << kDepthBits) |
+               (depth & kDepthMask);
+    }
+
+    // Maps a view-space distance in [0, maxDepth] to the 24-bit depth field.
+    static std::uint32_t QuantizeDepth(float depth, float maxDepth) {
+        const float t = depth <= 0.0f ? 0.0f : (depth >= maxDepth ? 1.0f : depth / maxDepth);
+        return static_cast<std::uint32_t>(t * static_cast<float>((1u << kDepthBits) - 1u));
+    }
+};
+
+class RenderQueue {
+public:
+    struct Item {
+        std::uint64_t key = 0;
+        // Caller-defined index into its per-frame draw data.
+        std::uint32_t payload = 0;
+    };
+
+    void Clear() { items_.clear(); }
+    void Push(std::uint64_t key, std::uint32_t payload) { items_.push_back(Item{key, payload}); }
+    // Sized fill for callers that build items in parallel; each index is written once.
+    void Resize(std::size_t count) { items_.resize(count); }
+    Item& operator[](std::size_t index) { return items_[index]; }
+
+    // Stable LSD radix sort, 8 bits per pass; passes where every key shares the digit are skipped.
+    void Sort();
+
+    const std::vector<Item>& Items() const { return items_; }
+    std::size_t Size() const { return items_.size(); }
+
+private:
+    std::vector<Item> items_;
+    std::vector<Item> scratch_;
+};
+
+} // namespace ow
@@ -0,0 +1,50 @@
+#pragma once
+
+// Renderer target module: offscreen colour and depth framebuffer for reduced internal resolution.
+
+namespace ow {
+
+// Colour (RGBA8) and depth (24-bit) texture attachments, both sampled with nearest
+// filtering so a later pass can read them back pixel for pixel. The attachments only
+// grow: a smaller size is drawn into the lower-left corner of the existing storage, so a
+// size that changes every few frames (dynamic resolution) does not reallocate.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // Sets the size in use, reallocating only when it exceeds the current storage. False
+    // (and reported once per allocation) if the driver rejects the framebuffer.
+    bool Resize(int width, int height);
+
+    // Binds the framebuffer for drawing.
+    void Bind() const;
+    // Nearest-neighbour copy of the used region of the colour attachment into a rectangle
+    // of the default framebuffer, which is left bound.
+    void BlitToDefault(int x, int y, int width, int height) const;
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+    // Storage size; texture coordinates of the used region end at Width()/AllocatedWidth().
+    int AllocatedWidth() const { return allocatedWidth_; }
+    int AllocatedHeight() const { return allocatedHeight_; }
+    unsigned int ColorTexture() const { return color_; }
+    unsigned int DepthTexture() const { return depth_; }
+
+private:
+    void Release();
+
+    unsigned int framebuffer_ = 0;
+    unsigned int color_ = 0;
+    unsigned int depth_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    int allocatedWidth_ = 0;
+    int allocatedHeight_ = 0;
+    bool complete_ = false;
+};
+
+} // namespace ow
@@ -0,0 +1,17 @@
+#pragma once
+
+// Renderer renderable module: mesh/material pair drawn for an entity.
+
+#include <memory>
+
+namespace ow {
+
+class Mesh;
+class Material;
+
+struct Renderable {
+    std::shared_ptr<Mesh> mesh;
+    std::shared_ptr<Material> material;
+};
+
+} // namespace ow
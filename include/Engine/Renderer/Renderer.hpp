@@ -2,17 +2,213 @@
 
 // Renderer module: central draw pass for scene entities.
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/Math.hpp"
+#include "Engine/Renderer/FrustumCuller.hpp"
+#include "Engine/Renderer/GpuProfiler.hpp"
+#include "Engine/Renderer/IndirectBuffer.hpp"
+#include "Engine/Renderer/InstanceBuffer.hpp"
+#include "Engine/Renderer/OverdrawMeter.hpp"
+#include "Engine/Renderer/PostProcess.hpp"
+#include "Engine/Renderer/RenderQueue.hpp"
+#include "Engine/Renderer/RenderTarget.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/ShaderVariants.hpp"
+#include "Engine/Renderer/StateTracker.hpp"
+#include "Engine/Renderer/StaticBatcher.hpp"
+#include "Engine/Renderer/UniformRing.hpp"
 #include "Engine/UI/DebugUI.hpp"
 
 namespace ow {
 
 class Scene;
 class Camera;
+class Material;
+class Mesh;
 
+// A frame is built in two halves. Prepare does all CPU work (BVH query, culling, ids,
+// keys, sorting, grouping, instance matrices, uniform staging) and issues no GL calls;
+// Submit only uploads the prepared buffers and issues binds and draws on the GL thread.
+// Prepared frames are double-buffered: Prepare fills the back frame and Submit draws the
+// front one, so Prepare for the next frame may run on another thread while Submit runs.
+// Swap, called while neither runs, makes the newest prepared frame the front.
 class Renderer {
 public:
-    void Render(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings) const;
+    // Prepare, Swap and Submit in turn. width and height are the window's drawable size;
+    // the scene itself is drawn at the internal size chosen by settings.resolutionMode.
+    void Render(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings);
+
+    // Reads the scene, which must not change until it returns. Any thread, one at a time.
+    void Prepare(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings);
+    void Swap();
+    // Draws the front frame once; does nothing when no prepared frame is waiting. Reads
+    // no scene state, and the frame keeps its meshes and materials alive, so the scene
+    // may be updated between Prepare and Submit. GL thread.
+    void Submit();
+    // True once a prepared frame has been swapped to the front and not yet submitted.
+    bool HasFrame() const { return frames_[1 - back_].ready; }
+
+    // Workers for Prepare; without one (or with nullptr) it runs on the calling thread.
+    void SetJobSystem(JobSystem* jobs) { jobs_ = jobs; }
+    // Optional; Submit brackets its passes with named GPU scopes.
+    void SetGpuProfiler(GpuProfiler* profiler) { profiler_ = profiler; }
+
+    // Full-screen effects applied once per pixel after the scene. While any is enabled
+    // the scene renders offscreen even at native resolution.
+    PostProcessChain& PostEffects() { return post_; }
+
+    // Counters from the most recent Submit.
+    const RenderStats& Stats() const { return stats_; }
+
+    // Opt-in static batching of static root entities; see StaticBatcher. Returns the
+    // number of batches. Batches with destroyed members fall back to per-entity draws.
+    std::size_t BuildStaticBatches(const Scene& scene);
+    void InvalidateStaticBatch(EntityId id);
+
+private:
+    // Sampler handles of the standard shader; its blocks are bound to the shared binding
+    // points when the program is first seen (and again after a recompile).
+    struct ShaderBindings {
+        std::uint32_t revision = 0;
+        UniformHandle textureAlbedo;
+        UniformHandle textureEmissive;
+    };
+
+    const ShaderBindings& BindingsFor(const Shader& shader);
+
+    std::unordered_map<const Shader*, ShaderBindings> bindings_;
+    UniformRing uniforms_;
+    // Per-frame state of each distinct material: its block's ring offset and program.
+    struct MaterialState {
+        // Keeps the material (and through it the program source) alive until Submit.
+        std::shared_ptr<const Material> material;
+        std::size_t uniformOffset = 0;
+        std::uint32_t shaderId = 0;
+        // Null until a missing variant is compiled in Submit.
+        const Shader* shader = nullptr;
+        ShaderVariants* variants = nullptr;
+        ShaderFeatureMask features = 0;
+        // Mask of the variant actually bound, which may be a stand-in subset of features.
+        ShaderFeatureMask resolvedFeatures = 0;
+        // Pre-pass program; its vertex stage must match the shading program's exactly.
+        const Shader* depthShader = nullptr;
+    };
+
+    // Run of sorted queue items sharing shader, material and mesh, resolved for Submit.
+    // commands[i] holds the draw parameters of groups[i]; baseInstance is its first item.
+    struct DrawGroup {
+        const Material* material = nullptr;
+        MaterialState* state = nullptr;
+        unsigned int vao = 0;
+        unsigned int indexType = 0;
+        // Byte offset into the arena index buffer, for the non-indirect path.
+        std::size_t indexOffset = 0;
+    };
+
+    // Everything Prepare hands to Submit. Nothing in it points into the scene.
+    struct PreparedFrame {
+        bool ready = false;
+        RenderSettings settings{};
+        // width/height are the internal size; present* is the window rectangle it is
+        // upscaled into.
+        int width = 0;
+        int height = 0;
+        int windowWidth = 0;
+        int windowHeight = 0;
+        bool offscreen = false;
+        int presentX = 0;
+        int presentY = 0;
+        int presentWidth = 0;
+        int presentHeight = 0;
+        UniformStaging uniforms;
+        std::size_t frameOffset = 0;
+        std::unordered_map<const Material*, MaterialState> materialStates;
+        std::vector<DrawGroup> groups;
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<InstanceData> instances;
+        // Meshes the groups draw from (LODs through their source mesh) and batch meshes
+        // dropped since the last frame, kept alive until the end of Submit. Submit clears
+        // these and materialStates so the last references are released on the GL thread.
+        std::vector<std::shared_ptr<const Mesh>> meshes;
+        // Scene counters; Submit adds its own and publishes them as Stats().
+        RenderStats stats{};
+    };
+    PreparedFrame frames_[2];
+    // Index of the frame Prepare writes; the other one is the front.
+    int back_ = 0;
+
+    // Prepare's scratch, reused between frames.
+    RenderQueue queue_;
+    // Program ids combine a dense source id (Shader or ShaderVariants) with the feature mask.
+    std::unordered_map<const void*, std::uint32_t> sourceIds_;
+    std::unordered_map<std::uint64_t, std::uint32_t> programIds_;
+    std::unordered_map<const void*, std::uint32_t> materialIds_;
+    std::unordered_map<const void*, std::uint32_t> meshIds_;
+    bool keyOverflowReported_ = false;
+    FrustumCuller culler_;
+    std::vector<std::uint32_t> candidates_;
+    std::vector<std::uint32_t> visible_;
+    std::vector<std::vector<std::uint32_t>> chunkVisible_;
+
+    // One visible mesh to draw: an entity's renderable or a whole static batch. The owners
+    // point at the renderable's (or batch's) shared pointers; for an LOD, meshOwner is
+    // the full mesh, which owns its levels.
+    struct DrawItem {
+        const Mesh* mesh = nullptr;
+        const Material* material = nullptr;
+        const Mat4* model = nullptr;
+        // 0 for the full mesh, otherwise 1 + index into the source mesh's Lods().
+        int lod = 0;
+        const std::shared_ptr<Mesh>* meshOwner = nullptr;
+        const std::shared_ptr<Material>* materialOwner = nullptr;
+    };
+    std::vector<DrawItem> draws_;
+
+    // Items per job chunk; a multiple of the culler's SIMD width.
+    static constexpr std::size_t kChunkSize = 256;
+
+    template <typename Fn>
+    void ForChunks(std::size_t count, Fn&& fn);
+
+    // Binds program, material block and textures (only the depth-only program for the
+    // pre-pass); the VAO and instance attribute pointers are left to the submission path.
+    // False when the group has no program.
+    bool BindDrawState(const DrawGroup& group, bool depthOnly);
+    // Both return the number of draw calls issued.
+    int SubmitGroups(const PreparedFrame& frame, bool depthOnly);
+    int SubmitIndirect(const PreparedFrame& frame, bool depthOnly);
+    bool UseDepthPrePass(const RenderSettings& settings);
+    // Internal size and present rectangle for a window of width x height. CPU only.
+    void ChooseResolution(PreparedFrame& frame, const RenderSettings& settings, int width, int height) const;
+
+    // Submit's GL state.
+    StateTracker state_;
+    const Material* boundMaterial_ = nullptr;
+    InstanceBuffer instanceBuffer_;
+    IndirectBuffer indirectBuffer_;
+    // -1 until queried from the first context the renderer draws with.
+    int indirectSupport_ = -1;
+
+    OverdrawMeter overdraw_;
+    // Current choice of DepthPrePassMode::Auto, kept between frames for hysteresis.
+    bool autoPrePass_ = false;
+
+    StaticBatcher staticBatches_;
+    RenderStats stats_{};
+
+    JobSystem* jobs_ = nullptr;
+    JobSystem serialJobs_{0};
+    GpuProfiler* profiler_ = nullptr;
+
+    // Reduced internal resolutions (and post-processed frames) render here and are
+    // upscaled into the window, by the post chain when it is active.
+    RenderTarget target_;
+    PostProcessChain post_;
 };
 
 } // namespace ow
@@ -2,30 +2,106 @@
 
 // Renderer shader module: compiles GLSL programs and exposes uniform helpers.
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "Engine/Core/Math.hpp"
 
 namespace ow {
 
+class ProgramCache;
+
+// Slot in a shader's reflected uniform table. Resolve once with Shader::Uniform and reuse
+// it every frame; an invalid handle (unknown or optimized-out uniform) makes setters no-ops.
+struct UniformHandle {
+    int slot = -1;
+
+    bool IsValid() const { return slot >= 0; }
+};
+
 class Shader {
 public:
     Shader() = default;
     ~Shader();
 
+    // Synchronous: BeginCompile followed by FinishCompile.
     bool Compile(const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Issues compile and link without reading back any status, so with
+    // GL_KHR_parallel_shader_compile the driver works on its own threads. A cached binary
+    // is used instead when the program cache has one. The previous program (if any) stays
+    // current until FinishCompile succeeds. Returns false only on an immediate failure.
+    bool BeginCompile(const std::string& vertexSource, const std::string& fragmentSource);
+    bool IsPending() const { return pendingProgram_ != 0; }
+    // True when FinishCompile will not block; always true without the extension.
+    bool IsReady() const;
+    // Waits if needed, checks status and installs the program.
+    bool FinishCompile();
     void Use() const;
 
-    void SetMat4(const char* name, const Mat4& value) const;
-    void SetVec2(const char* name, const Vec2& value) const;
-    void SetVec3(const char* name, const Vec3& value) const;
-    void SetInt(const char* name, int value) const;
-    void SetFloat(const char* name, float value) const;
+    UniformHandle Uniform(const char* name) const;
+
+    // Points a named uniform block at a buffer binding index. Returns false if the
+    // program does not declare (or the linker removed) the block.
+    bool BindUniformBlock(const char* name, unsigned int binding) const;
+
+    // Handle setters skip the GL call when the value matches the last one uploaded to this
+    // program. The program must be bound (Use) when a value actually changes.
+    void SetMat4(UniformHandle handle, const Mat4& value) const;
+    void SetMat3(UniformHandle handle, const Mat3& value) const;
+    void SetVec2(UniformHandle handle, const Vec2& value) const;
+    void SetVec3(UniformHandle handle, const Vec3& value) const;
+    void SetInt(UniformHandle handle, int value) const;
+    void SetFloat(UniformHandle handle, float value) const;
+
+    // Name-based convenience setters; these add a hash lookup per call.
+    void SetMat4(const char* name, const Mat4& value) const { SetMat4(Uniform(name), value); }
+    void SetMat3(const char* name, const Mat3& value) const { SetMat3(Uniform(name), value); }
+    void SetVec2(const char* name, const Vec2& value) const { SetVec2(Uniform(name), value); }
+    void SetVec3(const char* name, const Vec3& value) const { SetVec3(Uniform(name), value); }
+    void SetInt(const char* name, int value) const { SetInt(Uniform(name), value); }
+    void SetFloat(const char* name, float value) const { SetFloat(Uniform(name), value); }
 
     unsigned int Id() const { return programId_; }
+    // Changes on every successful Compile; lets callers invalidate handles they cached.
+    std::uint32_t Revision() const { return revision_; }
+    std::size_t UniformCount() const { return uniforms_.size(); }
+
+    // GL_KHR_parallel_shader_compile on the current context; queried once per process.
+    static bool ParallelCompileSupported();
+
+    // Programs are looked up in and written to this cache when set; nullptr disables it.
+    static void SetProgramCache(ProgramCache* cache) { programCache_ = cache; }
+    static ProgramCache* GetProgramCache() { return programCache_; }
 
 private:
+    struct UniformSlot {
+        int location = -1;
+        unsigned int type = 0;
+        bool hasValue = false;
+        // Last uploaded value, compared bytewise (ints are stored as raw bits).
+        float value[16]{};
+    };
+
+    void ReflectUniforms();
+    void DiscardPending();
+    // Returns false when data equals the cached value; otherwise stores it.
+    bool UpdateCache(UniformHandle handle, const void* data, std::size_t bytes) const;
+
+    static inline ProgramCache* programCache_ = nullptr;
+
     unsigned int programId_ = 0;
+    std::uint32_t revision_ = 0;
+
+    // In-flight BeginCompile; the stage objects are 0 when the binary came from the cache.
+    unsigned int pendingProgram_ = 0;
+    unsigned int pendingVertex_ = 0;
+    unsigned int pendingFragment_ = 0;
+    std::uint64_t pendingKey_ = 0;
+    mutable std::vector<UniformSlot> uniforms_;
+    std::unordered_map<std::string, int> slots_;
 };
 
 } // namespace ow
@@ -0,0 +1,70 @@
+#pragma once
+
+// Renderer shader variants module: specialized programs compiled from one source per feature mask.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ow {
+
+class Shader;
+
+// Each set bit becomes a #define in front of both stages, so disabled features are
+// compiled out rather than branched around at runtime.
+enum ShaderFeature : std::uint32_t {
+    kShaderFeaturePs2 = 1u << 0,             // OW_PS2
+    kShaderFeatureAlbedoTexture = 1u << 1,   // OW_ALBEDO_TEXTURE
+    kShaderFeatureEmissiveTexture = 1u << 2, // OW_EMISSIVE_TEXTURE
+    kShaderFeatureDepthOnly = 1u << 3,       // OW_DEPTH_ONLY: depth pre-pass, no shading
+};
+
+using ShaderFeatureMask = std::uint32_t;
+
+class ShaderVariants {
+public:
+    ShaderVariants(std::string vertexSource, std::string fragmentSource);
+
+    // Program for a feature mask, compiled on first request and waited for (needs the GL
+    // context). A failed compile is cached as nullptr so it is reported once.
+    std::shared_ptr<Shader> Get(ShaderFeatureMask features);
+
+    // Starts an asynchronous compile (see Shader::BeginCompile) unless the variant exists.
+    void Request(ShaderFeatureMask features);
+
+    // Non-blocking lookup for draws: requests the variant, installs it if the driver has
+    // finished, and otherwise returns the ready variant with the most of the requested
+    // features (nullptr if none is ready). resolved, if given, receives that variant's
+    // mask. GL thread.
+    const Shader* Resolve(ShaderFeatureMask features, ShaderFeatureMask* resolved = nullptr);
+
+    // As Resolve, but without a stand-in: nullptr until this exact variant is ready.
+    const Shader* Poll(ShaderFeatureMask features);
+
+    // Finished program, or nullptr; never touches GL, so frame preparation may call it on
+    // any thread while the GL thread compiles. Finished variants are never replaced.
+    const Shader* Find(ShaderFeatureMask features) const;
+
+    std::size_t VariantCount() const;
+    std::size_t PendingCount() const;
+
+    // source with one #define per feature bit inserted after its #version line.
+    static std::string Specialize(const std::string& source, ShaderFeatureMask features);
+
+private:
+    std::string vertexSource_;
+    std::string fragmentSource_;
+    // Fails the variant (nullptr entry) when its compile or link failed.
+    bool Finish(std::shared_ptr<Shader>& shader, ShaderFeatureMask features);
+    // Request and Poll with mutex_ already held.
+    void RequestLocked(ShaderFeatureMask features);
+    const Shader* PollLocked(ShaderFeatureMask features);
+
+    // Guards programs_ (and the pending state of its shaders) between the GL thread and Find.
+    mutable std::mutex mutex_;
+    std::unordered_map<ShaderFeatureMask, std::shared_ptr<Shader>> programs_;
+};
+
+} // namespace ow
@@ -0,0 +1,32 @@
+#pragma once
+
+// Renderer state module: shadows GL binding state to drop redundant bind calls.
+
+namespace ow {
+
+// Only tracks bindings the renderer changes per draw. Call Reset at the start of a pass,
+// since code outside the renderer (UI, loaders) binds objects behind its back.
+class StateTracker {
+public:
+    static constexpr int kTextureUnits = 8;
+
+    void Reset();
+
+    // Each returns true when the GL call was actually issued.
+    bool UseProgram(unsigned int program);
+    bool BindVertexArray(unsigned int vao);
+    bool BindTexture2D(int unit, unsigned int texture);
+
+    int Skipped() const { return skipped_; }
+
+private:
+    static constexpr unsigned int kUnknown = 0xFFFFFFFFu;
+
+    unsigned int program_ = kUnknown;
+    unsigned int vao_ = kUnknown;
+    int activeUnit_ = -1;
+    unsigned int textures_[kTextureUnits]{};
+    int skipped_ = 0;
+};
+
+} // namespace ow
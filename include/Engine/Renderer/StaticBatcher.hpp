@@ -0,0 +1,72 @@
+#pragma once
+
+// Renderer static batching module: merges immovable entities into per-material meshes.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine/Core/Bounds.hpp"
+#include "Engine/Scene/Registry.hpp"
+
+namespace ow {
+
+class Material;
+class Mesh;
+class Scene;
+
+struct StaticBatch {
+    std::shared_ptr<Material> material;
+    // World-space vertices of every member, one draw for the whole batch.
+    std::shared_ptr<Mesh> mesh;
+    Aabb bounds{};
+    std::vector<EntityId> members;
+    // Cleared when a member is removed or changed; members then draw individually again.
+    bool valid = true;
+};
+
+// Opt-in: call Build once the level is loaded. Candidates are root entities whose
+// Rigidbody is static and whose Renderable has a mesh and material. Batches are split so
+// none exceeds maxVertices (the default keeps indices in 16-bit range).
+class StaticBatcher {
+public:
+    std::size_t Build(const Scene& scene, std::size_t maxVertices = 65535);
+    void Clear();
+
+    // Drops the batch containing id, e.g. after its mesh, material or transform changed.
+    void Invalidate(EntityId id);
+    // Drops batches with destroyed members. Cheap unless the scene destroyed something.
+    void Validate(const Scene& scene);
+
+    // Moves the meshes of batches dropped since the last call into released. Dropping a
+    // batch may run off the GL thread, so its mesh is kept until the caller releases it.
+    void TakeReleased(std::vector<std::shared_ptr<const Mesh>>& released);
+
+    // True when id is drawn as part of a valid batch.
+    bool IsBatched(EntityId id) const;
+
+    const std::vector<StaticBatch>& Batches() const { return batches_; }
+    // Entities covered by valid batches, and the number of valid batches.
+    std::size_t BatchedCount() const { return batchedCount_; }
+    std::size_t ValidCount() const { return validCount_; }
+
+private:
+    int BatchOf(EntityId id) const;
+    void Drop(std::size_t batch);
+
+    struct Membership {
+        EntityId id{};
+        int batch = -1;
+    };
+
+    std::vector<StaticBatch> batches_;
+    // Meshes of dropped batches, waiting for TakeReleased.
+    std::vector<std::shared_ptr<const Mesh>> released_;
+    // Indexed by EntityId::index; the stored id rejects newer entities reusing the index.
+    std::vector<Membership> batchOf_;
+    std::size_t batchedCount_ = 0;
+    std::size_t validCount_ = 0;
+    std::uint64_t destroyCount_ = 0;
+};
+
+} // namespace ow
@@ -0,0 +1,48 @@
+#pragma once
+
+// Renderer uniform block module: std140 mirrors of the standard shader's uniform blocks.
+
+#include "Engine/Core/Math.hpp"
+
+namespace ow {
+
+// Binding points shared by every program that declares these blocks.
+enum UniformBlockBinding : unsigned int {
+    kFrameBlockBinding = 0,
+    kMaterialBlockBinding = 1,
+};
+
+// Member order must match the GLSL declarations. Each vec3 is followed by a scalar so the
+// pair fills one 16-byte std140 slot.
+
+// layout(std140) uniform FrameBlock
+struct FrameUniforms {
+    Mat4 view;
+    Mat4 projection;
+    Vec3 lightDir;
+    float ps2Jitter = 0.0f;
+    Vec3 lightColor;
+    float ps2ColorLevels = 0.0f;
+    Vec3 viewPos;
+    float ps2FogStrength = 0.0f;
+    Vec2 resolution;
+    int ps2Aesthetic = 0;
+    int shadeSteps = 0;
+};
+
+// layout(std140) uniform MaterialBlock
+struct MaterialUniforms {
+    Vec3 color;
+    float roughness = 0.0f;
+    Vec3 emissiveColor;
+    float emissiveStrength = 0.0f;
+    int useAlbedoTexture = 0;
+    int useEmissiveTexture = 0;
+    int padding[2]{};
+};
+
+static_assert(sizeof(Vec2) == 8 && sizeof(Vec3) == 12 && sizeof(Mat4) == 64, "std140 mirrors assume tightly packed math types");
+static_assert(sizeof(FrameUniforms) == 192, "FrameUniforms must match the std140 FrameBlock layout");
+static_assert(sizeof(MaterialUniforms) == 48, "MaterialUniforms must match the std140 MaterialBlock layout");
+
+} // namespace ow
@@ -0,0 +1,62 @@
+#pragma once
+
+// Renderer uniform ring module: per-frame sub-allocation of uniform block data in one UBO.
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ow {
+
+// One frame's uniform blocks, packed on the CPU. Touches no GL, so a frame can be staged
+// on any thread while another frame's staging is being uploaded.
+class UniformStaging {
+public:
+    // alignment is UniformRing::Alignment(), captured once per frame.
+    void Begin(std::size_t alignment);
+    // Copies size bytes into the staging area; returns the offset to pass to Bind.
+    std::size_t Push(const void* data, std::size_t size);
+
+    const unsigned char* Data() const { return data_.data(); }
+    std::size_t Size() const { return data_.size(); }
+
+private:
+    std::size_t alignment_ = 256;
+    std::vector<unsigned char> data_;
+};
+
+// Each frame's staged blocks are uploaded with a single glBufferSubData into one of
+// kSegments regions of a shared buffer and bound with glBindBufferRange. A fence per
+// region keeps the CPU from overwriting data the GPU is still reading.
+class UniformRing {
+public:
+    static constexpr int kSegments = 3;
+
+    UniformRing() = default;
+    ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    // Offset alignment staging must use; 256 until the first Upload queries the real
+    // value. Safe to read from any thread.
+    std::size_t Alignment() const { return alignment_.load(std::memory_order_relaxed); }
+
+    // Advances to the next segment and uploads staging into it. GL thread; call once per
+    // frame, before the first Bind.
+    void Upload(const UniformStaging& staging);
+    void Bind(unsigned int binding, std::size_t offset, std::size_t size) const;
+    void EndFrame();
+
+private:
+    void Reserve(std::size_t segmentSize);
+
+    unsigned int buffer_ = 0;
+    std::size_t segmentSize_ = 0;
+    // 256 until queried: no implementation reports a larger offset alignment.
+    std::atomic<std::size_t> alignment_{256};
+    int segment_ = 0;
+    void* fences_[kSegments]{};
+};
+
+} // namespace ow
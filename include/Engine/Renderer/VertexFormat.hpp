@@ -0,0 +1,46 @@
+#pragma once
+
+// Renderer vertex format module: full-float and packed vertex layouts plus encoders.
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Bounds.hpp"
+#include "Engine/Core/Math.hpp"
+
+namespace ow {
+
+struct Vertex {
+    Vec3 position;
+    Vec3 normal;
+    Vec2 uv;
+};
+
+enum class VertexFormat : std::uint8_t {
+    // 32 bytes: float position, normal and UV.
+    Float = 0,
+    // 16 bytes: snorm16 position inside the mesh bounds, 2_10_10_10 normal, half UV.
+    Packed,
+};
+
+struct PackedVertex {
+    // Maps [-1, 1] onto the mesh AABB; see Mesh::DecodeMatrix. w is padding.
+    std::int16_t position[4];
+    // GL_INT_2_10_10_10_REV, normalized; w (2 bits) unused.
+    std::uint32_t normal;
+    // IEEE half floats.
+    std::uint16_t uv[2];
+};
+
+static_assert(sizeof(Vertex) == 32, "Vertex is expected to be tightly packed");
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex is expected to be 16 bytes");
+
+std::size_t VertexStride(VertexFormat format);
+
+std::uint16_t FloatToHalf(float value);
+std::uint32_t PackNormal1010102(const Vec3& normal);
+
+// Positions are quantized relative to bounds (the mesh's local AABB).
+std::vector<PackedVertex> PackVertices(const std::vector<Vertex>& vertices, const Aabb& bounds);
+
+} // namespace ow
@@ -0,0 +1,40 @@
+#pragma once
+
+// Resource module: quadric error metric simplification and LOD chain generation.
+
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Renderer/VertexFormat.hpp"
+
+namespace ow {
+
+class Mesh;
+
+struct SimplifyResult {
+    // The input vertices, with every vertex that collapsed moved to where it ended up.
+    std::vector<Vertex> vertices;
+    // Triangles over vertices.
+    std::vector<unsigned int> indices;
+    // Largest distance from a moved vertex to the plane of any original triangle it
+    // absorbed, in mesh-space units.
+    float error = 0.0f;
+};
+
+class MeshSimplifier {
+public:
+    // Garland-Heckbert edge collapse onto existing positions, cheapest quadric error first,
+    // until at most targetIndexCount indices remain or nothing more can collapse without
+    // flipping a triangle. Adjacency is worked out on vertices welded by position, so the
+    // UV/normal seams the OBJ loader splits are interior edges; their copies collapse
+    // together and the seam stays closed. Only open borders and non-manifold edges are locked.
+    static SimplifyResult Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                   std::size_t targetIndexCount);
+
+    // Gives mesh up to maxLevels LODs, each with half the triangles of the one before
+    // and simplified from the full mesh. Stops early below minTriangles or when a level
+    // barely reduces. Returns the number of levels built.
+    static std::size_t BuildLods(Mesh& mesh, std::size_t maxLevels = 3, std::size_t minTriangles = 64);
+};
+
+} // namespace ow
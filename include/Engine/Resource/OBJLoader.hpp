@@ -11,6 +11,7 @@ class Mesh;
 
 class OBJLoader {
 public:
+    // Meshes large enough get an LOD chain (MeshSimplifier::BuildLods).
     static std::shared_ptr<Mesh> Load(const std::string& path);
 };
 
@@ -2,6 +2,7 @@
 
 // Scene camera module: first-person camera movement and view/projection helpers.
 
+#include "Engine/Core/Bounds.hpp"
 #include "Engine/Core/Math.hpp"
 
 namespace ow {
@@ -16,6 +17,9 @@ public:
     Mat4 ViewMatrix() const;
     Mat4 ProjectionMatrix(float aspect) const;
 
+    // World-space frustum planes derived from ProjectionMatrix(aspect) * ViewMatrix().
+    Frustum ViewFrustum(float aspect) const;
+
     Vec3 Front() const;
     Vec3 Right() const;
     Vec3 Up() const;
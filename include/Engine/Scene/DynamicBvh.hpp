@@ -0,0 +1,237 @@
+#pragma once
+
+// Scene spatial module: incrementally updated dynamic AABB tree (BVH) keyed by entity id.
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Bounds.hpp"
+#include "Engine/Scene/Registry.hpp"
+
+namespace ow {
+
+// Leaves store "fat" AABBs (tight box + margin) so small movements do not touch the tree.
+// Inserts pick the sibling with the lowest surface-area cost and AVL-style rotations keep
+// the tree balanced, which bounds query stack depth to a few dozen entries.
+class DynamicBvh {
+public:
+    static constexpr int kNull = -1;
+
+    explicit DynamicBvh(float margin = 0.2f) : margin_(margin) {}
+
+    // Returns a proxy id used for Remove/Move.
+    int Insert(const Aabb& box, EntityId id);
+    void Remove(int proxy);
+
+    // Updates a leaf; only reinserts when box escapes the fat AABB. displacement (expected
+    // movement until the next update) extends the fat box in the direction of travel.
+    // Returns true when the leaf was reinserted.
+    bool Move(int proxy, const Aabb& box, const Vec3& displacement = Vec3{0.0f, 0.0f, 0.0f});
+
+    const Aabb& FatAabb(int proxy) const { return nodes_[static_cast<std::size_t>(proxy)].box; }
+    EntityId UserData(int proxy) const { return nodes_[static_cast<std::size_t>(proxy)].id; }
+
+    int LeafCount() const { return leafCount_; }
+    int Height() const { return root_ == kNull ? 0 : nodes_[static_cast<std::size_t>(root_)].height; }
+
+    // Queries call fn(EntityId) for every leaf whose fat AABB passes the test;
+    // returning false from fn stops the query.
+    template <typename Fn>
+    void QueryAabb(const Aabb& box, Fn&& fn) const;
+
+    template <typename Fn>
+    void QuerySphere(const BoundingSphere& sphere, Fn&& fn) const;
+
+    // Subtrees fully inside the frustum are reported without further plane tests.
+    template <typename Fn>
+    void QueryFrustum(const Frustum& frustum, Fn&& fn) const;
+
+    // fn(EntityId, float entryDistance) returns the new max distance: return the hit
+    // distance to clip to the closest hit, maxDistance to keep going, or 0 to stop.
+    template <typename Fn>
+    void Raycast(const Vec3& origin, const Vec3& direction, float maxDistance, Fn&& fn) const;
+
+private:
+    static constexpr int kMaxStack = 256;
+
+    struct Node {
+        Aabb box{};
+        EntityId id{};
+        int parent = kNull;
+        int child1 = kNull;
+        int child2 = kNull;
+        // Leaf = 0, free node = -1.
+        int height = 0;
+
+        bool IsLeaf() const { return child1 == kNull; }
+    };
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int index);
+
+    template <typename Fn>
+    bool ReportSubtree(int index, Fn& fn) const;
+
+    std::vector<Node> nodes_;
+    int root_ = kNull;
+    int freeList_ = kNull;
+    int leafCount_ = 0;
+    float margin_;
+};
+
+template <typename Fn>
+void DynamicBvh::QueryAabb(const Aabb& box, Fn&& fn) const {
+    int stack[kMaxStack];
+    int top = 0;
+    if (root_ != kNull) {
+        stack[top++] = root_;
+    }
+
+    while (top > 0) {
+        const Node& node = nodes_[static_cast<std::size_t>(stack[--top])];
+        if (!node.box.Overlaps(box)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            if (!fn(node.id)) {
+                return;
+            }
+        } else if (top + 2 <= kMaxStack) {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Fn>
+void DynamicBvh::QuerySphere(const BoundingSphere& sphere, Fn&& fn) const {
+    const Vec3 r{sphere.radius, sphere.radius, sphere.radius};
+    QueryAabb(Aabb{sphere.center - r, sphere.center + r}, [&](EntityId id) {
+        return fn(id);
+    });
+}
+
+template <typename Fn>
+bool DynamicBvh::ReportSubtree(int index, Fn& fn) const {
+    int stack[kMaxStack];
+    int top = 0;
+    stack[top++] = index;
+    while (top > 0) {
+        const Node& node = nodes_[static_cast<std::size_t>(stack[--top])];
+        if (node.IsLeaf()) {
+            if (!fn(node.id)) {
+                return false;
+            }
+        } else if (top + 2 <= kMaxStack) {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+    return true;
+}
+
+template <typename Fn>
+void DynamicBvh::QueryFrustum(const Frustum& frustum, Fn&& fn) const {
+    int stack[kMaxStack];
+    int top = 0;
+    if (root_ != kNull) {
+        stack[top++] = root_;
+    }
+
+    while (top > 0) {
+        const int index = stack[--top];
+        const Node& node = nodes_[static_cast<std::size_t>(index)];
+
+        bool outside = false;
+        bool straddles = false;
+        for (const Plane& plane : frustum.planes) {
+            const Vec3& n = plane.normal;
+            const Vec3 far{n.x >= 0.0f ? node.box.max.x : node.box.min.x,
+                           n.y >= 0.0f ? node.box.max.y : node.box.min.y,
+                           n.z >= 0.0f ? node.box.max.z : node.box.min.z};
+            if (plane.Distance(far) < 0.0f) {
+                outside = true;
+                break;
+            }
+            const Vec3 nearCorner{n.x >= 0.0f ? node.box.min.x : node.box.max.x,
+                                  n.y >= 0.0f ? node.box.min.y : node.box.max.y,
+                                  n.z >= 0.0f ? node.box.min.z : node.box.max.z};
+            if (plane.Distance(nearCorner) < 0.0f) {
+                straddles = true;
+            }
+        }
+
+        if (outside) {
+            continue;
+        }
+        if (!straddles || node.IsLeaf()) {
+            if (!ReportSubtree(index, fn)) {
+                return;
+            }
+        } else if (top + 2 <= kMaxStack) {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Fn>
+void DynamicBvh::Raycast(const Vec3& origin, const Vec3& direction, float maxDistance, Fn&& fn) const {
+    const Vec3 dir = Normalize(direction);
+    const float kHuge = 1e30f;
+    const Vec3 invDir{
+        std::fabs(dir.x) > 1e-8f ? 1.0f / dir.x : kHuge,
+        std::fabs(dir.y) > 1e-8f ? 1.0f / dir.y : kHuge,
+        std::fabs(dir.z) > 1e-8f ? 1.0f / dir.z : kHuge,
+    };
+
+    // Slab test; returns the entry distance or a negative value on miss.
+    auto intersect = [&](const Aabb& box, float limit) {
+        float tMin = 0.0f;
+        float tMax = limit;
+        const float o[3] = {origin.x, origin.y, origin.z};
+        const float inv[3] = {invDir.x, invDir.y, invDir.z};
+        const float lo[3] = {box.min.x, box.min.y, box.min.z};
+        const float hi[3] = {box.max.x, box.max.y, box.max.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            float t0 = (lo[axis] - o[axis]) * inv[axis];
+            float t1 = (hi[axis] - o[axis]) * inv[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax) {
+                return -1.0f;
+            }
+        }
+        return tMin;
+    };
+
+    int stack[kMaxStack];
+    int top = 0;
+    if (root_ != kNull) {
+        stack[top++] = root_;
+    }
+
+    while (top > 0 && maxDistance > 0.0f) {
+        const Node& node = nodes_[static_cast<std::size_t>(stack[--top])];
+        const float t = intersect(node.box, maxDistance);
+        if (t < 0.0f) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            maxDistance = std::min(maxDistance, fn(node.id, t));
+        } else if (top + 2 <= kMaxStack) {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+} // namespace ow
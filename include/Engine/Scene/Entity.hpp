@@ -1,30 +1,61 @@
 #pragma once
 
-// Scene entity module: scene node that combines transform, mesh, material and collider radius.
+// Scene entity module: lightweight handle to an entity and its components in a Scene.
 
 #include <memory>
 #include <string>
 
-#include "Engine/Core/Transform.hpp"
+#include "Engine/Scene/Registry.hpp"
 
 namespace ow {
 
-class Mesh;
-class Material;
-struct Rigidbody;
+class Scene;
 
+// Copyable (scene, id) pair. Component data lives in the scene's registry pools; the
+// accessors below are conveniences for gameplay code, systems iterate the pools directly.
+// Component pointers/references are invalidated when components of that type are added.
+// A handle can outlive its entity: the reference accessors assert IsValid() and, in
+// release builds, return a default (empty name, identity transform) instead of touching
+// the pools; the pointer accessors return nullptr (the Add/Set ones without adding anything).
 class Entity {
 public:
-    explicit Entity(std::string entityName);
+    Entity() = default;
+    Entity(Scene* scene, EntityId id) : scene_(scene), id_(id) {}
 
-    std::string name;
-    Transform transform;
-    std::shared_ptr<Mesh> mesh;
-    std::shared_ptr<Material> material;
-    std::shared_ptr<Rigidbody> rigidbody;
+    EntityId Id() const { return id_; }
+    Scene* GetScene() const { return scene_; }
+    bool IsValid() const;
+    explicit operator bool() const { return IsValid(); }
 
-    // Physics collider radius used by simple sphere collision checks.
-    float colliderRadius = 0.5f;
+    bool operator==(const Entity& rhs) const { return scene_ == rhs.scene_ && id_ == rhs.id_; }
+    bool operator!=(const Entity& rhs) const { return !(*this == rhs); }
+
+    // Empty for an invalid handle.
+    const std::string& Name() const;
+
+    // Local transform, relative to the parent when the entity is attached to one.
+    // An invalid handle gets a default scratch transform; writes to it are discarded.
+    Transform& GetTransform() const;
+
+    Rigidbody* GetRigidbody() const;
+    Rigidbody* AddRigidbody(const Rigidbody& rigidbody = Rigidbody{}) const;
+
+    Collider* GetCollider() const;
+    Collider* AddCollider(float radius) const;
+
+    Renderable* GetRenderable() const;
+    Renderable* SetRenderable(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) const;
+
+    // World-space transform as of the last Scene::UpdateTransforms; identity for an
+    // invalid handle.
+    const Mat4& WorldMatrix() const;
+    Vec3 WorldPosition() const;
+
+    Entity Parent() const;
+
+private:
+    Scene* scene_ = nullptr;
+    EntityId id_{};
 };
 
 } // namespace ow
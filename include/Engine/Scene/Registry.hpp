@@ -0,0 +1,149 @@
+#pragma once
+
+// Scene registry module: generational entity ids and densely packed component pools.
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Transform.hpp"
+#include "Engine/Physics/Collider.hpp"
+#include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Renderer/Renderable.hpp"
+
+namespace ow {
+
+struct EntityId {
+    static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = kInvalidIndex;
+    std::uint32_t generation = 0;
+
+    bool IsValid() const { return index != kInvalidIndex; }
+    bool operator==(const EntityId& rhs) const { return index == rhs.index && generation == rhs.generation; }
+    bool operator!=(const EntityId& rhs) const { return !(*this == rhs); }
+};
+
+// Sparse set: components live contiguously in dense order, with a sparse table mapping
+// entity index -> dense slot. Iteration walks Data()/Owners() linearly.
+// Pointers and references into a pool are invalidated by Add/Remove on that pool.
+template <typename T>
+class ComponentPool {
+public:
+    T& Add(EntityId id, T value = T{}) {
+        if (T* existing = TryGet(id)) {
+            *existing = std::move(value);
+            return *existing;
+        }
+
+        if (id.index >= sparse_.size()) {
+            sparse_.resize(static_cast<std::size_t>(id.index) + 1, kEmpty);
+        }
+        sparse_[id.index] = static_cast<std::uint32_t>(dense_.size());
+        dense_.push_back(std::move(value));
+        owners_.push_back(id);
+        return dense_.back();
+    }
+
+    void Remove(EntityId id) {
+        if (!Has(id)) {
+            return;
+        }
+
+        const std::uint32_t slot = sparse_[id.index];
+        const std::uint32_t last = static_cast<std::uint32_t>(dense_.size() - 1);
+        if (slot != last) {
+            dense_[slot] = std::move(dense_[last]);
+            owners_[slot] = owners_[last];
+            sparse_[owners_[slot].index] = slot;
+        }
+        dense_.pop_back();
+        owners_.pop_back();
+        sparse_[id.index] = kEmpty;
+    }
+
+    bool Has(EntityId id) const {
+        return id.index < sparse_.size() && sparse_[id.index] != kEmpty && owners_[sparse_[id.index]] == id;
+    }
+
+    T* TryGet(EntityId id) { return Has(id) ? &dense_[sparse_[id.index]] : nullptr; }
+    const T* TryGet(EntityId id) const { return Has(id) ? &dense_[sparse_[id.index]] : nullptr; }
+
+    // Caller guarantees Has(id).
+    T& Get(EntityId id) { return dense_[sparse_[id.index]]; }
+    const T& Get(EntityId id) const { return dense_[sparse_[id.index]]; }
+
+    std::size_t Size() const { return dense_.size(); }
+    T* Data() { return dense_.data(); }
+    const T* Data() const { return dense_.data(); }
+    const EntityId* Owners() const { return owners_.data(); }
+
+    void Reserve(std::size_t count) {
+        dense_.reserve(count);
+        owners_.reserve(count);
+    }
+
+private:
+    static constexpr std::uint32_t kEmpty = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<T> dense_;
+    std::vector<EntityId> owners_;
+    std::vector<std::uint32_t> sparse_;
+};
+
+class Registry {
+public:
+    EntityId Create() {
+        EntityId id{};
+        if (!freeList_.empty()) {
+            id.index = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            id.index = static_cast<std::uint32_t>(generations_.size());
+            generations_.push_back(0);
+        }
+        id.generation = generations_[id.index];
+        ++aliveCount_;
+        return id;
+    }
+
+    void Destroy(EntityId id) {
+        if (!IsAlive(id)) {
+            return;
+        }
+        names.Remove(id);
+        transforms.Remove(id);
+        rigidbodies.Remove(id);
+        colliders.Remove(id);
+        renderables.Remove(id);
+
+        // Bumping the generation invalidates every outstanding copy of this id.
+        ++generations_[id.index];
+        freeList_.push_back(id.index);
+        --aliveCount_;
+        ++destroyCount_;
+    }
+
+    bool IsAlive(EntityId id) const { return id.index < generations_.size() && generations_[id.index] == id.generation; }
+    std::size_t AliveCount() const { return aliveCount_; }
+    // Upper bound on EntityId::index, for tables indexed by entity.
+    std::size_t Capacity() const { return generations_.size(); }
+    // Increases on every Destroy; lets caches holding entity ids detect removals cheaply.
+    std::uint64_t DestroyCount() const { return destroyCount_; }
+
+    ComponentPool<std::string> names;
+    ComponentPool<Transform> transforms;
+    ComponentPool<Rigidbody> rigidbodies;
+    ComponentPool<Collider> colliders;
+    ComponentPool<Renderable> renderables;
+
+private:
+    std::vector<std::uint32_t> generations_;
+    std::vector<std::uint32_t> freeList_;
+    std::size_t aliveCount_ = 0;
+    std::uint64_t destroyCount_ = 0;
+};
+
+} // namespace ow
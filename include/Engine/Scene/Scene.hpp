@@ -1,22 +1,54 @@
 #pragma once
 
-// Scene module: stores entities and world lighting settings.
+// Scene module: owns the entity registry, its hierarchy, spatial index and world lighting settings.
 
-#include <memory>
+#include <string>
 #include <vector>
 
+#include "Engine/Scene/DynamicBvh.hpp"
+#include "Engine/Scene/Entity.hpp"
 #include "Engine/Scene/Light.hpp"
+#include "Engine/Scene/Registry.hpp"
+#include "Engine/Scene/SceneGraph.hpp"
 
 namespace ow {
 
-class Entity;
-
 class Scene {
 public:
-    std::vector<std::shared_ptr<Entity>> entities;
+    Scene() : hierarchy(registry) {}
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    Registry registry;
+    SceneGraph hierarchy;
+    // World bounds of every entity with a mesh or collider, refreshed by UpdateTransforms.
+    DynamicBvh spatial;
     DirectionalLight light;
 
-    std::shared_ptr<Entity> AddEntity(const std::shared_ptr<Entity>& entity);
+    // Every entity gets a name and a Transform; other components are added on demand.
+    Entity CreateEntity(const std::string& name);
+    void DestroyEntity(Entity entity);
+
+    // Attaches child under parent; pass an invalid Entity to detach. Returns false on cycles.
+    bool SetParent(Entity child, Entity parent);
+
+    // Propagates world matrices for changed subtrees and moves their spatial proxies.
+    // Call after gameplay/physics, before rendering.
+    std::size_t UpdateTransforms();
+
+    // Queues an entity whose mesh or collider changed without its transform changing.
+    void MarkBoundsDirty(EntityId id) { boundsDirty_.push_back(id); }
+
+    std::size_t EntityCount() const { return registry.AliveCount(); }
+
+private:
+    bool WorldBounds(EntityId id, Aabb& out) const;
+    void RefreshBounds(EntityId id);
+    void RemoveProxy(EntityId id);
+
+    std::vector<int> proxyOf_;
+    std::vector<EntityId> boundsDirty_;
 };
 
 } // namespace ow
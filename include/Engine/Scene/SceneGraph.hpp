@@ -0,0 +1,58 @@
+#pragma once
+
+// Scene graph module: parent/child hierarchy stored as a depth-sorted flat array.
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Math.hpp"
+#include "Engine/Scene/Registry.hpp"
+
+namespace ow {
+
+// Nodes are kept ordered so every parent precedes its children. World matrices then
+// propagate in one linear pass, and only nodes whose local transform (or an ancestor's)
+// changed since the last pass are recomputed. Local transforms live in the registry.
+class SceneGraph {
+public:
+    explicit SceneGraph(Registry& registry) : registry_(registry) {}
+
+    SceneGraph(const SceneGraph&) = delete;
+    SceneGraph& operator=(const SceneGraph&) = delete;
+
+    void Add(EntityId id);
+    void Remove(EntityId id);
+
+    // Attaches child under parent (invalid id detaches). Fails if it would create a cycle.
+    bool SetParent(EntityId child, EntityId parent);
+    EntityId Parent(EntityId id) const;
+
+    // Recomputes dirty world matrices. Returns how many nodes were updated.
+    std::size_t Update();
+
+    // Entities whose world matrix was recomputed by the last Update, in hierarchy order.
+    const std::vector<EntityId>& Updated() const { return updated_; }
+
+    // World matrix as of the last Update.
+    const Mat4& WorldMatrix(EntityId id) const { return world_[static_cast<std::size_t>(nodeOf_[id.index])]; }
+    bool Contains(EntityId id) const;
+    std::size_t Size() const { return ids_.size(); }
+
+private:
+    int NodeOf(EntityId id) const { return Contains(id) ? nodeOf_[id.index] : -1; }
+    void RebuildOrder();
+
+    Registry& registry_;
+
+    std::vector<int> nodeOf_;
+    std::vector<EntityId> ids_;
+    std::vector<int> parents_;
+    std::vector<std::uint32_t> localVersions_;
+    std::vector<std::uint8_t> changed_;
+    std::vector<Mat4> world_;
+    std::vector<EntityId> updated_;
+
+    bool orderDirty_ = false;
+};
+
+} // namespace ow
@@ -3,6 +3,7 @@
 // UI module: debug HUD and settings overlay with lightweight built-in bitmap text.
 
 #include <string>
+#include <vector>
 
 #include "Engine/UI/AboutUI.hpp"
 
@@ -10,6 +11,23 @@ union SDL_Event;
 
 namespace ow {
 
+// Auto turns the pre-pass on when measured overdraw is high and off again when it drops.
+enum class DepthPrePassMode {
+    Off,
+    On,
+    Auto,
+};
+
+// Native renders straight to the window; the others render offscreen at a lower size
+// and are upscaled with nearest filtering. Fixed keeps its own aspect and is pillarboxed.
+// Dynamic is Scaled with the scale chosen each frame by DynamicResolution.
+enum class ResolutionMode {
+    Native,
+    Scaled,
+    Fixed,
+    Dynamic,
+};
+
 struct RenderSettings {
     bool wireframe = false;
     bool vSync = true;
@@ -19,6 +37,52 @@ struct RenderSettings {
     int ps2ColorLevels = 12;
     float ps2Jitter = 1.1f;
     float ps2FogStrength = 0.82f;
+    // Submit with glMultiDrawElementsIndirect when the context supports it (GL 4.3).
+    bool multiDrawIndirect = true;
+    // Depth-only pass before shading, which then tests GL_EQUAL so each pixel shades once.
+    DepthPrePassMode depthPrePass = DepthPrePassMode::Auto;
+    ResolutionMode resolutionMode = ResolutionMode::Native;
+    // Fraction of the window size in Scaled mode (and Dynamic, where it is overwritten).
+    float resolutionScale = 0.5f;
+    // Internal size in Fixed mode; 640x448 is the common PS2 frame.
+    int fixedWidth = 640;
+    int fixedHeight = 448;
+    // Each +1 doubles the screen-space error allowed before a mesh drops to a coarser LOD.
+    float lodBias = 0.0f;
+};
+
+// Per-frame renderer counters shown in the HUD.
+struct RenderStats {
+    int submitted = 0;
+    int visible = 0;
+    int culled = 0;
+    int drawCalls = 0;
+    bool indirect = false;
+    bool indirectSupported = false;
+    // Depth-tested fragments per pixel, a few frames old (see OverdrawMeter).
+    float overdraw = 0.0f;
+    bool depthPrePass = false;
+    // Internal resolution the scene was rendered at.
+    int renderWidth = 0;
+    int renderHeight = 0;
+    // Visible draws using a simplified LOD instead of the full mesh.
+    int lodDraws = 0;
+};
+
+// Dynamic resolution controller state for the HUD; headroom is budgetMs - costMs.
+struct DynamicResolutionStats {
+    bool active = false;
+    float scale = 1.0f;
+    float costMs = 0.0f;
+    float budgetMs = 0.0f;
+};
+
+// One profiled GPU scope (see GpuProfiler), shown in the HUD indented by depth.
+struct GpuTiming {
+    const char* name = "";
+    int depth = 0;
+    float ms = 0.0f;
+    float averageMs = 0.0f;
 };
 
 class DebugUI {
@@ -39,6 +103,9 @@ public:
     void Render(bool settingsOpen) const;
 
     const RenderSettings& Settings() const { return settings_; }
+    void SetRenderStats(const RenderStats& stats) { renderStats_ = stats; }
+    void SetGpuTimings(const std::vector<GpuTiming>& timings) { gpuTimings_ = timings; }
+    void SetDynamicResolution(const DynamicResolutionStats& stats) { dynamicResolution_ = stats; }
 
 private:
     void AppendRect(float x, float y, float w, float h, float r, float g, float b, float a) const;
@@ -50,9 +117,10 @@ private:
     mutable unsigned int vbo_ = 0;
     unsigned int shaderProgram_ = 0;
 
-    mutable float* vertices_ = nullptr;
-    mutable int vertexCount_ = 0;
-    mutable int vertexCapacity_ = 0;
+    // Interleaved x, y, r, g, b, a; rebuilt every Render.
+    mutable std::vector<float> vertices_;
+    // Vertices the GL buffer can hold; grown (never shrunk) when the text outgrows it.
+    mutable int bufferCapacity_ = 0;
 
     int viewportWidth_ = 1280;
     int viewportHeight_ = 720;
@@ -63,6 +131,9 @@ private:
     bool aboutOpen_ = false;
 
     RenderSettings settings_{};
+    RenderStats renderStats_{};
+    std::vector<GpuTiming> gpuTimings_;
+    DynamicResolutionStats dynamicResolution_{};
     AboutUI aboutUi_{};
 };
 
@@ -0,0 +1,85 @@
+#include "Engine/Core/JobSystem.hpp"
+
+namespace ow {
+
+unsigned int JobSystem::DefaultWorkerCount() {
+    const unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 1 ? threads - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    workers_.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobSystem::Run(std::size_t chunkCount, const std::function<void(std::size_t)>& job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        chunkCount_ = chunkCount;
+        nextChunk_.store(0, std::memory_order_relaxed);
+        finished_ = 0;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    // The caller works too, then waits for chunks still running on workers.
+    const std::size_t completed = Drain(job, chunkCount);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_ += completed;
+    done_.wait(lock, [&] { return finished_ == chunkCount && active_ == 0; });
+    job_ = nullptr;
+}
+
+std::size_t JobSystem::Drain(const std::function<void(std::size_t)>& job, std::size_t chunkCount) {
+    std::size_t completed = 0;
+    for (std::size_t chunk = nextChunk_.fetch_add(1); chunk < chunkCount; chunk = nextChunk_.fetch_add(1)) {
+        job(chunk);
+        ++completed;
+    }
+    return completed;
+}
+
+void JobSystem::WorkerLoop() {
+    std::uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(std::size_t)>* job = nullptr;
+        std::size_t chunkCount = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || (job_ != nullptr && generation_ != seen); });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            job = job_;
+            chunkCount = chunkCount_;
+            ++active_;
+        }
+
+        const std::size_t completed = Drain(*job, chunkCount);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ += completed;
+            --active_;
+        }
+        done_.notify_all();
+    }
+}
+
+} // namespace ow
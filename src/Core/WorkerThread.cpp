@@ -0,0 +1,59 @@
+#include "Engine/Core/WorkerThread.hpp"
+
+#include <utility>
+
+namespace ow {
+
+WorkerThread::WorkerThread() {
+    thread_ = std::thread([this] { Loop(); });
+}
+
+WorkerThread::~WorkerThread() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return !busy_; });
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void WorkerThread::Post(std::function<void()> task) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return !busy_; });
+        task_ = std::move(task);
+        busy_ = true;
+    }
+    wake_.notify_one();
+}
+
+void WorkerThread::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return !busy_; });
+}
+
+void WorkerThread::Loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || busy_; });
+            if (stopping_) {
+                return;
+            }
+            task = std::move(task_);
+            task_ = nullptr;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_ = false;
+        }
+        done_.notify_all();
+    }
+}
+
+} // namespace ow
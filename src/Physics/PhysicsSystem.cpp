@@ -1,9 +1,13 @@
 #include "Engine/Physics/PhysicsSystem.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "Engine/Core/Math.hpp"
+#include "Engine/Core/VectorStream.hpp"
+#include "Engine/Physics/Collider.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Scene/Entity.hpp"
 #include "Engine/Scene/Scene.hpp"
@@ -14,38 +18,89 @@ namespace {
 
 const Vec3 kGravity{0.0f, -9.81f, 0.0f};
 
-float InverseMass(const Entity& entity) {
-    if (!entity.rigidbody || entity.rigidbody->isStatic) {
-        return 0.0f;
+// Flat per-step view of one collider. Pointers reference registry pools, which are not
+// resized while the step runs.
+struct Body {
+    Transform* transform = nullptr;
+    Rigidbody* rigidbody = nullptr;
+    float radius = 0.0f;
+    // Attached entities follow their parent and are treated as kinematic by the solver.
+    bool attached = false;
+    Vec3 attachedPosition{0.0f, 0.0f, 0.0f};
+
+    bool IsDynamic() const { return rigidbody && !rigidbody->isStatic && !attached; }
+    float InverseMass() const { return IsDynamic() ? rigidbody->inverseMass : 0.0f; }
+
+    // Roots read the live local position (it changes during the step); attached bodies
+    // use the world position from the last hierarchy update.
+    Vec3 Position() const { return attached ? attachedPosition : transform->Position(); }
+};
+
+// SoA copy of every dynamic body so integration runs 8 bodies per iteration.
+struct BodyStreams {
+    std::vector<Body*> bodies;
+    Vec3Stream position;
+    Vec3Stream velocity;
+    Vec3Stream acceleration;
+    FloatStream damping;
+
+    void Gather() {
+        const std::size_t count = bodies.size();
+        position.Resize(count);
+        velocity.Resize(count);
+        acceleration.Resize(count);
+        damping.Resize(count, 1.0f);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const Body& body = *bodies[i];
+            const Rigidbody& rb = *body.rigidbody;
+
+            Vec3 totalForce = rb.accumulatedForce;
+            if (rb.useGravity) {
+                totalForce += kGravity * rb.mass;
+            }
+
+            position.Set(i, body.transform->Position());
+            velocity.Set(i, rb.velocity);
+            acceleration.Set(i, totalForce * rb.inverseMass);
+            damping[i] = std::clamp(rb.linearDamping, 0.0f, 1.0f);
+        }
     }
-    return entity.rigidbody->inverseMass;
-}
 
-void Integrate(Entity& entity, float dt) {
-    if (!entity.rigidbody || entity.rigidbody->isStatic) {
-        return;
+    void Scatter() {
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            Body& body = *bodies[i];
+            body.transform->SetPosition(position.Get(i));
+            body.rigidbody->velocity = velocity.Get(i);
+            body.rigidbody->accumulatedForce = Vec3{0.0f, 0.0f, 0.0f};
+        }
     }
+};
 
-    auto& rb = *entity.rigidbody;
-    Vec3 totalForce = rb.accumulatedForce;
-    if (rb.useGravity) {
-        totalForce += kGravity * rb.mass;
+void Integrate(BodyStreams& streams, float dt) {
+    if (streams.bodies.empty()) {
+        return;
     }
 
-    const Vec3 acceleration = totalForce * rb.inverseMass;
-    rb.velocity += acceleration * dt;
+    streams.Gather();
 
-    const float damping = std::clamp(rb.linearDamping, 0.0f, 1.0f);
-    rb.velocity = rb.velocity * damping;
-    entity.transform.position += rb.velocity * dt;
+    const simd::Float8 dtLanes = simd::Splat8(dt);
+    for (std::size_t i = 0; i < streams.position.PaddedSize(); i += Vec3Stream::kLanes) {
+        Vec3x8 velocity = MulAdd(streams.acceleration.Load8(i), dtLanes, streams.velocity.Load8(i));
+        velocity = Scale(velocity, streams.damping.Load8(i));
+        const Vec3x8 position = MulAdd(velocity, dtLanes, streams.position.Load8(i));
 
-    rb.accumulatedForce = Vec3{0.0f, 0.0f, 0.0f};
+        streams.velocity.Store(i, velocity);
+        streams.position.Store(i, position);
+    }
+
+    streams.Scatter();
 }
 
-void ResolvePair(Entity& a, Entity& b) {
-    const Vec3 delta = b.transform.position - a.transform.position;
+void ResolvePair(Body& a, Body& b) {
+    const Vec3 delta = b.Position() - a.Position();
     float distance = Length(delta);
-    const float minDistance = a.colliderRadius + b.colliderRadius;
+    const float minDistance = a.radius + b.radius;
     if (distance >= minDistance || minDistance <= 0.0f) {
         return;
     }
@@ -57,8 +112,8 @@ void ResolvePair(Entity& a, Entity& b) {
         distance = 0.0f;
     }
 
-    const float invMassA = InverseMass(a);
-    const float invMassB = InverseMass(b);
+    const float invMassA = a.InverseMass();
+    const float invMassB = b.InverseMass();
     const float invMassSum = invMassA + invMassB;
     if (invMassSum <= 0.0f) {
         return;
@@ -68,8 +123,13 @@ void ResolvePair(Entity& a, Entity& b) {
     const float penetration = minDistance - distance;
     const float correctionPercent = 0.8f;
     const Vec3 correction = normal * (penetration * correctionPercent / invMassSum);
-    a.transform.position += correction * -invMassA;
-    b.transform.position += correction * invMassB;
+    // Only touch bodies that actually move so static transforms keep their cached matrix.
+    if (invMassA > 0.0f) {
+        a.transform->Translate(correction * -invMassA);
+    }
+    if (invMassB > 0.0f) {
+        b.transform->Translate(correction * invMassB);
+    }
 
     Vec3 velocityA{0.0f, 0.0f, 0.0f};
     Vec3 velocityB{0.0f, 0.0f, 0.0f};
@@ -98,14 +158,60 @@ void ResolvePair(Entity& a, Entity& b) {
     const float j = -(1.0f + restitution) * velocityAlongNormal / invMassSum;
     const Vec3 impulse = normal * j;
 
-    if (a.rigidbody && !a.rigidbody->isStatic) {
+    if (a.IsDynamic()) {
         a.rigidbody->velocity += impulse * -invMassA;
     }
-    if (b.rigidbody && !b.rigidbody->isStatic) {
+    if (b.IsDynamic()) {
         b.rigidbody->velocity += impulse * invMassB;
     }
 }
 
+// Broadphase: candidate pairs for the whole step, gathered from the scene BVH. Query boxes
+// are grown by how far bodies can travel during the step (estimated from the velocity at
+// the start), so pairs that only come into contact mid-step are still found.
+void CollectPairs(const Scene& scene, const std::vector<Body>& bodies, const std::vector<EntityId>& ids,
+                  float deltaTime, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) {
+    std::vector<int> bodyOf(scene.registry.Capacity(), -1);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        bodyOf[ids[i].index] = static_cast<int>(i);
+    }
+
+    const float gravityTravel = 0.5f * Length(kGravity) * deltaTime * deltaTime;
+    std::vector<float> sweep(bodies.size(), 0.0f);
+    float maxSweep = 0.0f;
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i].IsDynamic()) {
+            sweep[i] = Length(bodies[i].rigidbody->velocity) * deltaTime + gravityTravel;
+            maxSweep = std::max(maxSweep, sweep[i]);
+        }
+    }
+
+    pairs.clear();
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        // Pairs without a dynamic body never resolve, so only dynamic bodies query.
+        if (!bodies[i].IsDynamic()) {
+            continue;
+        }
+
+        const float reach = bodies[i].radius + sweep[i] + maxSweep;
+        const Vec3 center = bodies[i].Position();
+        const Vec3 extent{reach, reach, reach};
+        scene.spatial.QueryAabb(Aabb{center - extent, center + extent}, [&](EntityId id) {
+            const int j = bodyOf[id.index];
+            if (j >= 0 && static_cast<std::size_t>(j) != i && ids[static_cast<std::size_t>(j)] == id) {
+                const auto a = static_cast<std::uint32_t>(i);
+                const auto b = static_cast<std::uint32_t>(j);
+                pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+            return true;
+        });
+    }
+
+    // Both bodies of a dynamic pair report it; sorting also keeps the old i < j solve order.
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
+
 } // namespace
 
 void PhysicsSystem::Step(Scene& scene, float deltaTime, int substeps) {
@@ -116,31 +222,64 @@ void PhysicsSystem::Step(Scene& scene, float deltaTime, int substeps) {
     const int iterations = std::max(1, substeps);
     const float dt = deltaTime / static_cast<float>(iterations);
 
-    std::vector<Entity*> bodies;
-    bodies.reserve(scene.entities.size());
-    for (const auto& e : scene.entities) {
-        if (e && e->colliderRadius > 0.0f) {
-            bodies.push_back(e.get());
+    scene.UpdateTransforms();
+
+    Registry& registry = scene.registry;
+    const Collider* colliders = registry.colliders.Data();
+    const EntityId* owners = registry.colliders.Owners();
+
+    std::vector<Body> bodies;
+    std::vector<EntityId> ids;
+    bodies.reserve(registry.colliders.Size());
+    ids.reserve(registry.colliders.Size());
+    for (std::size_t i = 0; i < registry.colliders.Size(); ++i) {
+        if (colliders[i].radius <= 0.0f) {
+            continue;
         }
+
+        const EntityId id = owners[i];
+        Body body{};
+        body.transform = &registry.transforms.Get(id);
+        body.rigidbody = registry.rigidbodies.TryGet(id);
+        body.radius = colliders[i].radius;
+        body.attached = scene.hierarchy.Parent(id).IsValid();
+        if (body.attached) {
+            const Mat4& world = scene.hierarchy.WorldMatrix(id);
+            body.attachedPosition = Vec3{world[12], world[13], world[14]};
+        }
+        bodies.push_back(body);
+        ids.push_back(id);
     }
 
-    for (int step = 0; step < iterations; ++step) {
-        for (Entity* entity : bodies) {
-            Integrate(*entity, dt);
+    BodyStreams dynamicBodies;
+    for (Body& body : bodies) {
+        if (body.IsDynamic()) {
+            dynamicBodies.bodies.push_back(&body);
         }
+    }
 
-        for (std::size_t i = 0; i < bodies.size(); ++i) {
-            for (std::size_t j = i + 1; j < bodies.size(); ++j) {
-                ResolvePair(*bodies[i], *bodies[j]);
-            }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+    CollectPairs(scene, bodies, ids, deltaTime, pairs);
+
+    for (int step = 0; step < iterations; ++step) {
+        Integrate(dynamicBodies, dt);
+
+        for (const auto& pair : pairs) {
+            ResolvePair(bodies[pair.first], bodies[pair.second]);
         }
     }
 }
 
 bool PhysicsSystem::CheckSphereCollision(const Entity& a, const Entity& b) {
-    const Vec3 delta = a.transform.position - b.transform.position;
+    const Collider* colliderA = a.GetCollider();
+    const Collider* colliderB = b.GetCollider();
+    if (!colliderA || !colliderB) {
+        return false;
+    }
+
+    const Vec3 delta = a.WorldPosition() - b.WorldPosition();
     const float distance = Length(delta);
-    return distance <= (a.colliderRadius + b.colliderRadius);
+    return distance <= (colliderA->radius + colliderB->radius);
 }
 
 } // namespace ow
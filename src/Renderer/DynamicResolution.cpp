@@ -0,0 +1,92 @@
+#include "Engine/Renderer/DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ow {
+
+namespace {
+
+// Over kOverBudget of the budget lowers the scale after kOverFrames frames; under
+// kUnderBudget raises it after kUnderFrames. Raising is deliberately slow.
+const float kOverBudget = 0.95f;
+const float kUnderBudget = 0.75f;
+const int kOverFrames = 3;
+const int kUnderFrames = 45;
+// Cost the scale is lowered to aim for, as a fraction of the budget.
+const float kTargetBudget = 0.85f;
+const float kScaleStep = 0.05f;
+// Longer than the GPU profiler's readback latency so stale timings are not acted on.
+const int kSettleFrames = 8;
+const float kCostSmoothing = 0.15f;
+
+} // namespace
+
+void DynamicResolution::SetRange(float minScale, float maxScale) {
+    minScale_ = std::clamp(minScale, 0.1f, 1.0f);
+    maxScale_ = std::clamp(maxScale, minScale_, 1.0f);
+    scale_ = std::clamp(scale_, minScale_, maxScale_);
+}
+
+void DynamicResolution::Reset() {
+    scale_ = maxScale_;
+    costMs_ = 0.0f;
+    overFrames_ = 0;
+    underFrames_ = 0;
+    settleFrames_ = 0;
+}
+
+void DynamicResolution::Update(float cpuMs, float gpuMs) {
+    const float cost = gpuMs > 0.0f ? gpuMs : cpuMs;
+    if (cost <= 0.0f || budgetMs_ <= 0.0f) {
+        return;
+    }
+    costMs_ = costMs_ <= 0.0f ? cost : costMs_ + (cost - costMs_) * kCostSmoothing;
+
+    if (settleFrames_ > 0) {
+        --settleFrames_;
+        return;
+    }
+
+    if (costMs_ > budgetMs_ * kOverBudget) {
+        ++overFrames_;
+        underFrames_ = 0;
+    } else if (costMs_ < budgetMs_ * kUnderBudget) {
+        ++underFrames_;
+        overFrames_ = 0;
+    } else {
+        overFrames_ = 0;
+        underFrames_ = 0;
+    }
+
+    float scale = scale_;
+    if (overFrames_ >= kOverFrames) {
+        // Fragment cost follows pixel count, i.e. the square of the scale.
+        scale = std::min(scale_ - kScaleStep, scale_ * std::sqrt(budgetMs_ * kTargetBudget / costMs_));
+    } else if (underFrames_ >= kUnderFrames) {
+        scale = scale_ + kScaleStep;
+    } else {
+        return;
+    }
+
+    // Whole steps keep the internal size from drifting by a pixel or two every change.
+    scale = std::round(scale / kScaleStep) * kScaleStep;
+    scale = std::clamp(scale, minScale_, maxScale_);
+    overFrames_ = 0;
+    underFrames_ = 0;
+    if (scale != scale_) {
+        scale_ = scale;
+        settleFrames_ = kSettleFrames;
+    }
+}
+
+DynamicResolutionStats DynamicResolution::Stats() const {
+    DynamicResolutionStats stats;
+    stats.active = true;
+    stats.scale = scale_;
+    stats.costMs = costMs_;
+    stats.budgetMs = budgetMs_;
+    return stats;
+}
+
+} // namespace ow
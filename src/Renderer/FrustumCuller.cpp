@@ -0,0 +1,61 @@
+#include "Engine/Renderer/FrustumCuller.hpp"
+
+#include <algorithm>
+
+namespace ow {
+
+void FrustumCuller::Reset(std::size_t count) {
+    centers_.Resize(count);
+    radii_.Resize(count);
+}
+
+void FrustumCuller::Set(std::size_t index, const BoundingSphere& sphere) {
+    centers_.Set(index, sphere.center);
+    radii_[index] = sphere.radius;
+}
+
+void FrustumCuller::Cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const {
+    Cull(frustum, 0, centers_.Size(), visible);
+}
+
+void FrustumCuller::Cull(const Frustum& frustum, std::size_t begin, std::size_t end, std::vector<std::uint32_t>& visible) const {
+    const std::size_t count = std::min(end, centers_.Size());
+    if (begin >= count) {
+        return;
+    }
+
+    Vec3x8 normals[Frustum::Count];
+    simd::Float8 offsets[Frustum::Count];
+    for (int p = 0; p < Frustum::Count; ++p) {
+        normals[p] = Splat8(frustum.planes[p].normal);
+        offsets[p] = simd::Splat8(frustum.planes[p].d);
+    }
+
+    const simd::Float8 zero = simd::Splat8(0.0f);
+    for (std::size_t i = begin; i < count; i += Vec3Stream::kLanes) {
+        const Vec3x8 center = centers_.Load8(i);
+        const simd::Float8 negRadius = simd::Sub(zero, radii_.Load8(i));
+
+        simd::Mask8 outside = simd::CmpLt(simd::Add(Dot(normals[0], center), offsets[0]), negRadius);
+        for (int p = 1; p < Frustum::Count; ++p) {
+            const simd::Float8 distance = simd::Add(Dot(normals[p], center), offsets[p]);
+            outside = simd::Or(outside, simd::CmpLt(distance, negRadius));
+        }
+
+        int inside = ~simd::MoveMask(outside) & 0xFF;
+        while (inside != 0) {
+            int lane = 0;
+            while ((inside & (1 << lane)) == 0) {
+                ++lane;
+            }
+            inside &= inside - 1;
+
+            const std::size_t index = i + static_cast<std::size_t>(lane);
+            if (index < count) {
+                visible.push_back(static_cast<std::uint32_t>(index));
+            }
+        }
+    }
+}
+
+} // namespace ow
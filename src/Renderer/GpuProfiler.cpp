@@ -0,0 +1,138 @@
+#include "Engine/Renderer/GpuProfiler.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace ow {
+
+GpuProfiler::~GpuProfiler() {
+    for (FrameSlot& slot : slots_) {
+        if (!slot.pool.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.pool.size()), slot.pool.data());
+        }
+    }
+}
+
+unsigned int GpuProfiler::AcquireQuery(FrameSlot& slot) {
+    if (slot.poolUsed == slot.pool.size()) {
+        unsigned int query = 0;
+        glGenQueries(1, &query);
+        slot.pool.push_back(query);
+    }
+    return slot.pool[slot.poolUsed++];
+}
+
+void GpuProfiler::BeginFrame() {
+    if (!enabled_) {
+        return;
+    }
+
+    current_ = (current_ + 1) % kFrameLatency;
+    FrameSlot& slot = slots_[current_];
+    if (slot.pending) {
+        Resolve(slot);
+    }
+
+    slot.scopes.clear();
+    slot.poolUsed = 0;
+    slot.frame = frameIndex_++;
+    openScopes_.clear();
+    depth_ = 0;
+    inFrame_ = true;
+}
+
+void GpuProfiler::EndFrame() {
+    if (!inFrame_) {
+        return;
+    }
+    while (!openScopes_.empty()) {
+        EndScope();
+    }
+    FrameSlot& slot = slots_[current_];
+    slot.pending = !slot.scopes.empty();
+    inFrame_ = false;
+}
+
+void GpuProfiler::BeginScope(const char* name) {
+    if (!inFrame_) {
+        return;
+    }
+    FrameSlot& slot = slots_[current_];
+    Scope scope;
+    scope.name = name;
+    scope.depth = depth_++;
+    scope.begin = AcquireQuery(slot);
+    glQueryCounter(scope.begin, GL_TIMESTAMP);
+    openScopes_.push_back(static_cast<int>(slot.scopes.size()));
+    slot.scopes.push_back(scope);
+}
+
+void GpuProfiler::EndScope() {
+    if (!inFrame_ || openScopes_.empty()) {
+        return;
+    }
+    FrameSlot& slot = slots_[current_];
+    Scope& scope = slot.scopes[static_cast<std::size_t>(openScopes_.back())];
+    openScopes_.pop_back();
+    scope.end = AcquireQuery(slot);
+    glQueryCounter(scope.end, GL_TIMESTAMP);
+    --depth_;
+}
+
+void GpuProfiler::Resolve(FrameSlot& slot) {
+    slot.pending = false;
+
+    // Queries complete in submission order, so the last one issued stands for all of them.
+    GLint available = 0;
+    glGetQueryObjectiv(slot.pool[slot.poolUsed - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == 0) {
+        ++dropped_;
+        return;
+    }
+
+    std::vector<GpuTiming> timings;
+    timings.reserve(slot.scopes.size());
+    for (const Scope& scope : slot.scopes) {
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(scope.begin, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(scope.end, GL_QUERY_RESULT, &end);
+
+        GpuTiming timing;
+        timing.name = scope.name;
+        timing.depth = scope.depth;
+        timing.ms = end > begin ? static_cast<float>(static_cast<double>(end - begin) * 1e-6) : 0.0f;
+        timing.averageMs = timing.ms;
+        for (const GpuTiming& previous : timings_) {
+            if (std::strcmp(previous.name, scope.name) == 0 && previous.depth == scope.depth) {
+                timing.averageMs = previous.averageMs + (timing.ms - previous.averageMs) * 0.1f;
+                break;
+            }
+        }
+        timings.push_back(timing);
+    }
+    timings_ = timings;
+
+    history_.push_back(HistoryEntry{slot.frame, std::move(timings)});
+    if (history_.size() > kHistoryFrames) {
+        history_.pop_front();
+    }
+}
+
+bool GpuProfiler::ExportCsv(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << "frame,scope,depth,ms\n";
+    for (const HistoryEntry& entry : history_) {
+        for (const GpuTiming& timing : entry.timings) {
+            file << entry.frame << ',' << timing.name << ',' << timing.depth << ',' << timing.ms << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace ow
@@ -0,0 +1,49 @@
+#include "Engine/Renderer/IndirectBuffer.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <algorithm>
+
+namespace ow {
+
+IndirectBuffer::~IndirectBuffer() {
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);
+    }
+}
+
+bool IndirectBuffer::Supported() {
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 3)) {
+        return true;
+    }
+    return HasGLExtension("GL_ARB_multi_draw_indirect") && HasGLExtension("GL_ARB_base_instance");
+}
+
+void IndirectBuffer::Upload(const std::vector<DrawElementsIndirectCommand>& commands) {
+    if (buffer_ == 0) {
+        glGenBuffers(1, &buffer_);
+    }
+
+    const std::size_t bytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer_);
+    if (bytes > capacity_) {
+        capacity_ = std::max<std::size_t>(bytes, capacity_ * 2);
+    }
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, GL_STREAM_DRAW);
+    if (bytes > 0) {
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(bytes), commands.data());
+    }
+}
+
+void IndirectBuffer::Draw(unsigned int indexType, std::size_t first, std::size_t count) const {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer_);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, indexType,
+                                reinterpret_cast<void*>(first * sizeof(DrawElementsIndirectCommand)),
+                                static_cast<GLsizei>(count), 0);
+}
+
+} // namespace ow
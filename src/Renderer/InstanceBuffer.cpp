@@ -0,0 +1,54 @@
+#include "Engine/Renderer/InstanceBuffer.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ow {
+
+InstanceBuffer::~InstanceBuffer() {
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);
+    }
+}
+
+void InstanceBuffer::Upload(const std::vector<InstanceData>& instances) {
+    if (buffer_ == 0) {
+        glGenBuffers(1, &buffer_);
+    }
+
+    const std::size_t bytes = instances.size() * sizeof(InstanceData);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+    if (bytes > capacity_) {
+        capacity_ = std::max<std::size_t>(bytes, capacity_ * 2);
+    }
+    // Orphan last frame's storage so the driver does not stall on draws still reading it.
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, GL_STREAM_DRAW);
+    if (bytes > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), instances.data());
+    }
+}
+
+void InstanceBuffer::Bind(std::size_t firstInstance) const {
+    const GLsizei stride = sizeof(InstanceData);
+    const std::size_t base = firstInstance * sizeof(InstanceData);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+    for (unsigned int column = 0; column < 4; ++column) {
+        const unsigned int location = kInstanceModelLocation + column;
+        const std::size_t offset = base + offsetof(InstanceData, model) + column * 4 * sizeof(float);
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(location, 1);
+    }
+    for (unsigned int column = 0; column < 3; ++column) {
+        const unsigned int location = kInstanceNormalLocation + column;
+        const std::size_t offset = base + offsetof(InstanceData, normalMatrix) + column * 3 * sizeof(float);
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+} // namespace ow
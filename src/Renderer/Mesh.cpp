@@ -2,13 +2,17 @@
 
 #include "Engine/Renderer/GL.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 
 #include <utility>
 
 namespace ow {
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, VertexFormat format)
+    : format_(format) {
     Upload(vertices, indices);
 }
 
@@ -17,80 +21,95 @@ Mesh::~Mesh() {
 }
 
 Mesh::Mesh(Mesh&& other) noexcept {
-    vao_ = other.vao_;
-    vbo_ = other.vbo_;
-    ebo_ = other.ebo_;
-    indexCount_ = other.indexCount_;
-
-    other.vao_ = 0;
-    other.vbo_ = 0;
-    other.ebo_ = 0;
-    other.indexCount_ = 0;
+    allocation_ = other.allocation_;
+    format_ = other.format_;
+    bounds_ = other.bounds_;
+    sphere_ = other.sphere_;
+    vertices_ = std::move(other.vertices_);
+    indices_ = std::move(other.indices_);
+    lods_ = std::move(other.lods_);
+
+    other.allocation_ = MeshAllocation{};
 }
 
 Mesh& Mesh::operator=(Mesh&& other) noexcept {
     if (this != &other) {
         Release();
-        vao_ = other.vao_;
-        vbo_ = other.vbo_;
-        ebo_ = other.ebo_;
-        indexCount_ = other.indexCount_;
-
-        other.vao_ = 0;
-        other.vbo_ = 0;
-        other.ebo_ = 0;
-        other.indexCount_ = 0;
+        allocation_ = other.allocation_;
+        format_ = other.format_;
+        bounds_ = other.bounds_;
+        sphere_ = other.sphere_;
+        vertices_ = std::move(other.vertices_);
+        indices_ = std::move(other.indices_);
+        lods_ = std::move(other.lods_);
+
+        other.allocation_ = MeshAllocation{};
     }
     return *this;
 }
 
 void Mesh::Upload(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    indexCount_ = static_cast<int>(indices.size());
-
-    glGenVertexArrays(1, &vao_);
-    glGenBuffers(1, &vbo_);
-    glGenBuffers(1, &ebo_);
-
-    glBindVertexArray(vao_);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<long>(vertices.size() * sizeof(Vertex)), vertices.data(), GL_STATIC_DRAW);
+    ComputeBounds(vertices);
+    vertices_ = vertices;
+    indices_ = indices;
+
+    MeshArena& arena = MeshArena::Shared(format_);
+    if (format_ == VertexFormat::Packed) {
+        const std::vector<PackedVertex> packed = PackVertices(vertices, bounds_);
+        allocation_ = arena.Allocate(packed.data(), packed.size(), indices);
+    } else {
+        allocation_ = arena.Allocate(vertices.data(), vertices.size(), indices);
+    }
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<long>(indices.size() * sizeof(unsigned int)), indices.data(), GL_STATIC_DRAW);
+unsigned int Mesh::IndexType() const {
+    return allocation_.indexSize == sizeof(std::uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+Mat4 Mesh::DecodeMatrix() const {
+    if (format_ != VertexFormat::Packed) {
+        return Mat4::Identity();
+    }
+    return Mat4::Translation(bounds_.Center()) * Mat4::Scale(bounds_.Extents());
+}
 
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+void Mesh::ComputeBounds(const std::vector<Vertex>& vertices) {
+    if (vertices.empty()) {
+        bounds_ = Aabb{};
+        sphere_ = BoundingSphere{};
+        return;
+    }
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
+    bounds_.min = vertices[0].position;
+    bounds_.max = vertices[0].position;
+    for (const Vertex& v : vertices) {
+        bounds_.min = Vec3{std::min(bounds_.min.x, v.position.x), std::min(bounds_.min.y, v.position.y), std::min(bounds_.min.z, v.position.z)};
+        bounds_.max = Vec3{std::max(bounds_.max.x, v.position.x), std::max(bounds_.max.y, v.position.y), std::max(bounds_.max.z, v.position.z)};
+    }
 
-    glBindVertexArray(0);
+    // Sphere around the box center; radius from the farthest vertex is tighter than the half-diagonal.
+    sphere_.center = bounds_.Center();
+    float radiusSq = 0.0f;
+    for (const Vertex& v : vertices) {
+        const Vec3 d = v.position - sphere_.center;
+        radiusSq = std::max(radiusSq, Dot(d, d));
+    }
+    sphere_.radius = std::sqrt(radiusSq);
 }
 
 void Mesh::Draw() const {
-    glBindVertexArray(vao_);
-    glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
+    if (!allocation_.IsValid()) {
+        return;
+    }
+    glBindVertexArray(VertexArray());
+    glDrawElementsBaseVertex(GL_TRIANGLES, IndexCount(), IndexType(),
+                             reinterpret_cast<void*>(allocation_.indexOffset), allocation_.baseVertex);
     glBindVertexArray(0);
 }
 
 void Mesh::Release() {
-    if (ebo_ != 0) {
-        glDeleteBuffers(1, &ebo_);
-        ebo_ = 0;
-    }
-    if (vbo_ != 0) {
-        glDeleteBuffers(1, &vbo_);
-        vbo_ = 0;
-    }
-    if (vao_ != 0) {
-        glDeleteVertexArrays(1, &vao_);
-        vao_ = 0;
-    }
-    indexCount_ = 0;
+    MeshArena::Shared(format_).Free(allocation_);
+    allocation_ = MeshAllocation{};
 }
 
 std::shared_ptr<Mesh> Mesh::CreateCube(float halfExtent) {
@@ -0,0 +1,253 @@
+#include "Engine/Renderer/MeshArena.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace ow {
+
+namespace {
+
+const std::size_t kInitialVertices = 64 * 1024;
+const std::size_t kInitialIndexBytes = 1024 * 1024;
+
+// Copies the live range of a buffer into a new, larger one and returns the new name.
+unsigned int Regrow(unsigned int oldBuffer, std::size_t oldBytes, std::size_t newBytes) {
+    unsigned int buffer = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newBytes), nullptr, GL_STATIC_DRAW);
+    if (oldBuffer != 0 && oldBytes > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(oldBytes));
+        glDeleteBuffers(1, &oldBuffer);
+    }
+    return buffer;
+}
+
+} // namespace
+
+void FreeListAllocator::Reset(std::size_t capacity) {
+    free_.clear();
+    capacity_ = capacity;
+    used_ = 0;
+    if (capacity > 0) {
+        free_.emplace(0, capacity);
+    }
+}
+
+void FreeListAllocator::Grow(std::size_t capacity) {
+    if (capacity <= capacity_) {
+        return;
+    }
+    const std::size_t oldCapacity = capacity_;
+    capacity_ = capacity;
+    Insert(oldCapacity, capacity - oldCapacity);
+}
+
+std::size_t FreeListAllocator::Allocate(std::size_t size, std::size_t alignment) {
+    if (size == 0) {
+        return kInvalid;
+    }
+
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+        const std::size_t blockStart = it->first;
+        const std::size_t blockSize = it->second;
+        const std::size_t start = (blockStart + alignment - 1) / alignment * alignment;
+        const std::size_t padding = start - blockStart;
+        if (padding + size > blockSize) {
+            continue;
+        }
+
+        free_.erase(it);
+        if (padding > 0) {
+            free_.emplace(blockStart, padding);
+        }
+        const std::size_t tail = blockSize - padding - size;
+        if (tail > 0) {
+            free_.emplace(start + size, tail);
+        }
+        used_ += size;
+        return start;
+    }
+    return kInvalid;
+}
+
+void FreeListAllocator::Free(std::size_t offset, std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+    used_ -= size;
+    Insert(offset, size);
+}
+
+void FreeListAllocator::Insert(std::size_t offset, std::size_t size) {
+    auto next = free_.lower_bound(offset);
+
+    // Merge with the preceding block when it ends exactly at offset.
+    if (next != free_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            free_.erase(prev);
+        }
+    }
+    // And with the following block when it starts right after.
+    if (next != free_.end() && offset + size == next->first) {
+        size += next->second;
+        free_.erase(next);
+    }
+    free_.emplace(offset, size);
+}
+
+MeshArena& MeshArena::Shared(VertexFormat format) {
+    static MeshArena floatArena(VertexFormat::Float);
+    static MeshArena packedArena(VertexFormat::Packed);
+    return format == VertexFormat::Packed ? packedArena : floatArena;
+}
+
+void MeshArena::ShutdownShared() {
+    Shared(VertexFormat::Float).Shutdown();
+    Shared(VertexFormat::Packed).Shutdown();
+}
+
+MeshArena::~MeshArena() {
+    Shutdown();
+}
+
+void MeshArena::Shutdown() {
+    if (ebo_ != 0) {
+        glDeleteBuffers(1, &ebo_);
+        ebo_ = 0;
+    }
+    if (vbo_ != 0) {
+        glDeleteBuffers(1, &vbo_);
+        vbo_ = 0;
+    }
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    vertices_.Reset(0);
+    indexBytes_.Reset(0);
+}
+
+void MeshArena::Init() {
+    glGenVertexArrays(1, &vao_);
+    vertices_.Reset(0);
+    indexBytes_.Reset(0);
+    GrowVertices(kInitialVertices);
+    GrowIndices(kInitialIndexBytes);
+}
+
+void MeshArena::SetupAttributes() {
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+
+    if (format_ == VertexFormat::Packed) {
+        const GLsizei stride = sizeof(PackedVertex);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, position)));
+
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, normal)));
+
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, uv)));
+    } else {
+        const GLsizei stride = sizeof(Vertex);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, position)));
+
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, normal)));
+
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, uv)));
+    }
+
+    glBindVertexArray(0);
+}
+
+void MeshArena::GrowVertices(std::size_t minVertices) {
+    std::size_t capacity = std::max(vertices_.Capacity(), kInitialVertices);
+    while (capacity < minVertices) {
+        capacity *= 2;
+    }
+    const std::size_t stride = VertexStride(format_);
+    vbo_ = Regrow(vbo_, vertices_.Capacity() * stride, capacity * stride);
+    vertices_.Grow(capacity);
+    // Attribute pointers capture the buffer name, so they must be re-specified.
+    SetupAttributes();
+}
+
+void MeshArena::GrowIndices(std::size_t minBytes) {
+    std::size_t capacity = std::max(indexBytes_.Capacity(), kInitialIndexBytes);
+    while (capacity < minBytes) {
+        capacity *= 2;
+    }
+    ebo_ = Regrow(ebo_, indexBytes_.Capacity(), capacity);
+    indexBytes_.Grow(capacity);
+    SetupAttributes();
+}
+
+MeshAllocation MeshArena::Allocate(const void* vertices, std::size_t vertexCount, const std::vector<unsigned int>& indices) {
+    if (vertexCount == 0 || indices.empty()) {
+        return MeshAllocation{};
+    }
+    if (vao_ == 0) {
+        Init();
+    }
+
+    std::size_t firstVertex = vertices_.Allocate(vertexCount);
+    while (firstVertex == FreeListAllocator::kInvalid) {
+        GrowVertices(vertices_.Capacity() * 2);
+        firstVertex = vertices_.Allocate(vertexCount);
+    }
+
+    // Indices are relative to the base vertex, so 16 bits suffice below 65536 vertices.
+    const std::size_t indexSize = vertexCount <= 0xFFFFu ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+    const std::size_t indexBytes = indices.size() * indexSize;
+    std::size_t indexOffset = indexBytes_.Allocate(indexBytes, indexSize);
+    while (indexOffset == FreeListAllocator::kInvalid) {
+        GrowIndices(indexBytes_.Capacity() * 2);
+        indexOffset = indexBytes_.Allocate(indexBytes, indexSize);
+    }
+
+    const std::size_t stride = VertexStride(format_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(firstVertex * stride),
+                    static_cast<GLsizeiptr>(vertexCount * stride), vertices);
+
+    // Index uploads go through the copy target so no VAO's element binding is disturbed.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo_);
+    if (indexSize == sizeof(std::uint16_t)) {
+        const std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(indexOffset), static_cast<GLsizeiptr>(indexBytes), narrow.data());
+    } else {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(indexOffset), static_cast<GLsizeiptr>(indexBytes), indices.data());
+    }
+
+    MeshAllocation allocation;
+    allocation.baseVertex = static_cast<std::int32_t>(firstVertex);
+    allocation.vertexCount = static_cast<std::uint32_t>(vertexCount);
+    allocation.indexOffset = indexOffset;
+    allocation.indexCount = static_cast<std::uint32_t>(indices.size());
+    allocation.indexSize = static_cast<std::uint8_t>(indexSize);
+    return allocation;
+}
+
+void MeshArena::Free(const MeshAllocation& allocation) {
+    // Allocations made before a Shutdown no longer exist.
+    if (!allocation.IsValid() || vao_ == 0) {
+        return;
+    }
+    vertices_.Free(static_cast<std::size_t>(allocation.baseVertex), allocation.vertexCount);
+    indexBytes_.Free(allocation.indexOffset, static_cast<std::size_t>(allocation.indexCount) * allocation.indexSize);
+}
+
+} // namespace ow
@@ -0,0 +1,45 @@
+#include "Engine/Renderer/OverdrawMeter.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+namespace ow {
+
+OverdrawMeter::~OverdrawMeter() {
+    if (queries_[0] != 0) {
+        glDeleteQueries(kLatency, queries_);
+    }
+}
+
+void OverdrawMeter::Begin() {
+    if (queries_[0] == 0) {
+        glGenQueries(kLatency, queries_);
+    }
+
+    slot_ = (slot_ + 1) % kLatency;
+    if (pending_[slot_]) {
+        pending_[slot_] = false;
+        GLint available = 0;
+        glGetQueryObjectiv(queries_[slot_], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available != 0 && pixels_[slot_] > 0) {
+            GLuint64 samples = 0;
+            glGetQueryObjectui64v(queries_[slot_], GL_QUERY_RESULT, &samples);
+            const float overdraw = static_cast<float>(static_cast<double>(samples) / static_cast<double>(pixels_[slot_]));
+            overdraw_ = overdraw_ <= 0.0f ? overdraw : overdraw_ + (overdraw - overdraw_) * 0.2f;
+        }
+    }
+
+    glBeginQuery(GL_SAMPLES_PASSED, queries_[slot_]);
+    active_ = true;
+}
+
+void OverdrawMeter::End(int pixelCount) {
+    if (!active_) {
+        return;
+    }
+    glEndQuery(GL_SAMPLES_PASSED);
+    pixels_[slot_] = pixelCount;
+    pending_[slot_] = true;
+    active_ = false;
+}
+
+} // namespace ow
@@ -0,0 +1,175 @@
+#include "Engine/Renderer/PostProcess.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include "Engine/Renderer/RenderTarget.hpp"
+#include "Engine/Renderer/UniformBlocks.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace ow {
+
+namespace {
+
+// Full-screen triangle from gl_VertexID; no vertex buffers.
+const char* kPostVertexShader = R"(
+#version 330 core
+void main() {
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// Mirrors FrameUniforms in UniformBlocks.hpp.
+const char* kPostPrologue = R"(
+#version 330 core
+layout(std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uLightDir;
+    float uPs2Jitter;
+    vec3 uLightColor;
+    float uPs2ColorLevels;
+    vec3 uViewPos;
+    float uPs2FogStrength;
+    vec2 uResolution;
+    int uPs2Aesthetic;
+    int uShadeSteps;
+};
+
+uniform sampler2D uSceneColor;
+uniform sampler2D uSceneDepth;
+uniform vec2 uPresentOrigin;
+uniform vec2 uPresentSize;
+uniform vec2 uSceneSize;
+
+out vec4 FragColor;
+
+struct PostPixel {
+    vec2 coord;
+    float depth;
+    float viewDepth;
+    bool background;
+};
+)";
+
+const char* kPostMainBegin = R"(
+void main() {
+    vec2 local = (gl_FragCoord.xy - uPresentOrigin) / uPresentSize;
+    ivec2 texel = ivec2(clamp(floor(local * uSceneSize), vec2(0.0), uSceneSize - 1.0));
+
+    PostPixel p;
+    p.coord = vec2(texel) + 0.5;
+    p.depth = texelFetch(uSceneDepth, texel, 0).r;
+    p.background = p.depth >= 1.0;
+    p.viewDepth = uProjection[3][2] / (p.depth * 2.0 - 1.0 + uProjection[2][2]);
+
+    vec3 color = texelFetch(uSceneColor, texel, 0).rgb;
+)";
+
+} // namespace
+
+PostProcessChain::PostProcessChain() = default;
+
+PostProcessChain::~PostProcessChain() {
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+    }
+}
+
+void PostProcessChain::Add(PostEffect effect) {
+    if (effects_.size() >= 32) {
+        std::cerr << "Post effect " << effect.name << " ignored: chain is full\n";
+        return;
+    }
+    effects_.push_back(std::move(effect));
+}
+
+std::uint32_t PostProcessChain::EnabledMask(const RenderSettings& settings) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < effects_.size(); ++i) {
+        if (!effects_[i].enabled || effects_[i].enabled(settings)) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+bool PostProcessChain::Active(const RenderSettings& settings) const {
+    return EnabledMask(settings) != 0;
+}
+
+std::string PostProcessChain::FragmentSource(std::uint32_t mask) const {
+    std::string source = kPostPrologue;
+    for (std::size_t i = 0; i < effects_.size(); ++i) {
+        if ((mask & (1u << i)) != 0) {
+            source += effects_[i].source;
+            source += '\n';
+        }
+    }
+    source += kPostMainBegin;
+    for (std::size_t i = 0; i < effects_.size(); ++i) {
+        if ((mask & (1u << i)) != 0) {
+            source += "    color = " + effects_[i].function + "(color, p);\n";
+        }
+    }
+    source += "    FragColor = vec4(color, 1.0);\n}\n";
+    return source;
+}
+
+bool PostProcessChain::Apply(const RenderTarget& scene, const RenderSettings& settings, int x, int y, int width, int height) {
+    const std::uint32_t mask = EnabledMask(settings);
+    auto found = programs_.find(mask);
+    if (found == programs_.end()) {
+        Program program;
+        program.shader = std::make_unique<Shader>();
+        if (program.shader->Compile(kPostVertexShader, FragmentSource(mask))) {
+            program.shader->BindUniformBlock("FrameBlock", kFrameBlockBinding);
+            program.shader->Use();
+            program.shader->SetInt("uSceneColor", 0);
+            program.shader->SetInt("uSceneDepth", 1);
+            program.presentOrigin = program.shader->Uniform("uPresentOrigin");
+            program.presentSize = program.shader->Uniform("uPresentSize");
+            program.sceneSize = program.shader->Uniform("uSceneSize");
+        } else {
+            std::cerr << "Post-process chain 0x" << std::hex << mask << std::dec << " failed to compile\n";
+            program.shader.reset();
+        }
+        found = programs_.emplace(mask, std::move(program)).first;
+    }
+    const Program& program = found->second;
+    if (!program.shader) {
+        return false;
+    }
+    const Shader& shader = *program.shader;
+
+    if (vao_ == 0) {
+        glGenVertexArrays(1, &vao_);
+    }
+
+    shader.Use();
+    shader.SetVec2(program.presentOrigin, Vec2{static_cast<float>(x), static_cast<float>(y)});
+    shader.SetVec2(program.presentSize, Vec2{static_cast<float>(width), static_cast<float>(height)});
+    shader.SetVec2(program.sceneSize, Vec2{static_cast<float>(scene.Width()), static_cast<float>(scene.Height())});
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, scene.ColorTexture());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, scene.DepthTexture());
+
+    glViewport(x, y, width, height);
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(vao_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+    return true;
+}
+
+} // namespace ow
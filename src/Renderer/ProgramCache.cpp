@@ -0,0 +1,171 @@
+#include "Engine/Renderer/ProgramCache.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace ow {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x4250574Fu; // "OWPB"
+constexpr std::uint32_t kVersion = 1;
+// Far above any real program binary; a larger length means the file is corrupt.
+constexpr std::uint32_t kMaxBinaryLength = 64u * 1024u * 1024u;
+
+struct BinaryHeader {
+    std::uint32_t magic = kMagic;
+    std::uint32_t version = kVersion;
+    std::uint32_t format = 0;
+    std::uint32_t length = 0;
+};
+
+std::uint64_t Fnv1a(std::uint64_t hash, const std::string& text) {
+    for (const char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ull;
+    }
+    // Separator so "ab"+"c" and "a"+"bc" hash differently.
+    hash ^= 0xFFu;
+    hash *= 0x100000001B3ull;
+    return hash;
+}
+
+std::string GLString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+} // namespace
+
+bool ProgramCache::Open(const std::string& directory) {
+    open_ = false;
+
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    const bool core = major > 4 || (major == 4 && minor >= 1);
+    if (!core && !HasGLExtension("GL_ARB_get_program_binary")) {
+        return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Program cache disabled, cannot create " << directory << ": " << error.message() << '\n';
+        return false;
+    }
+
+    directory_ = directory;
+    driver_ = GLString(GL_VENDOR) + '\n' + GLString(GL_RENDERER) + '\n' + GLString(GL_VERSION);
+    open_ = true;
+    return true;
+}
+
+std::uint64_t ProgramCache::Key(const std::string& vertexSource, const std::string& fragmentSource) const {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    hash = Fnv1a(hash, vertexSource);
+    hash = Fnv1a(hash, fragmentSource);
+    hash = Fnv1a(hash, driver_);
+    return hash;
+}
+
+std::string ProgramCache::PathFor(std::uint64_t key) const {
+    char name[32]{};
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+bool ProgramCache::Load(std::uint64_t key, unsigned int program) {
+    if (!open_) {
+        return false;
+    }
+
+    const std::string path = PathFor(key);
+    std::ifstream file(path, std::ios::binary);
+    BinaryHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != kMagic || header.version != kVersion || header.length == 0) {
+        ++misses_;
+        return false;
+    }
+
+    // A corrupt or rejected binary is deleted so the next run stores a fresh one.
+    auto discard = [&] {
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        ++misses_;
+        return false;
+    };
+
+    // The length comes from disk: check it against the file before allocating for it.
+    std::error_code sizeError;
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+    if (sizeError || header.length > kMaxBinaryLength || fileSize != sizeof(header) + std::uintmax_t{header.length}) {
+        return discard();
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        return discard();
+    }
+
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        return discard();
+    }
+
+    ++hits_;
+    return true;
+}
+
+void ProgramCache::Store(std::uint64_t key, unsigned int program) {
+    if (!open_) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    BinaryHeader header;
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+    header.format = format;
+    header.length = static_cast<std::uint32_t>(written);
+
+    // Write to a temporary name first so a crash never leaves a truncated binary behind.
+    const std::string path = PathFor(key);
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(binary.data(), written)) {
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+}
+
+} // namespace ow
@@ -0,0 +1,53 @@
+#include "Engine/Renderer/RenderQueue.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace ow {
+
+void RenderQueue::Sort() {
+    const std::size_t count = items_.size();
+    if (count < 2) {
+        return;
+    }
+
+    // One histogram per digit, built in a single read of the keys.
+    std::uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const Item& item : items_) {
+        for (int digit = 0; digit < 8; ++digit) {
+            ++histograms[digit][(item.key >> (digit * 8)) & 0xFFu];
+        }
+    }
+
+    scratch_.resize(count);
+    Item* src = items_.data();
+    Item* dst = scratch_.data();
+
+    for (int digit = 0; digit < 8; ++digit) {
+        std::uint32_t* histogram = histograms[digit];
+        const unsigned int first = static_cast<unsigned int>((src[0].key >> (digit * 8)) & 0xFFu);
+        if (histogram[first] == count) {
+            continue;
+        }
+
+        std::uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            const std::uint32_t n = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += n;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const unsigned int bucket = static_cast<unsigned int>((src[i].key >> (digit * 8)) & 0xFFu);
+            dst[histogram[bucket]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != items_.data()) {
+        items_.swap(scratch_);
+    }
+}
+
+} // namespace ow
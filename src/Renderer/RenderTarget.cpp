@@ -0,0 +1,90 @@
+#include "Engine/Renderer/RenderTarget.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ow {
+
+namespace {
+
+unsigned int CreateAttachment(GLint internalFormat, GLenum format, GLenum type, int width, int height) {
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+} // namespace
+
+RenderTarget::~RenderTarget() {
+    Release();
+}
+
+void RenderTarget::Release() {
+    if (framebuffer_ != 0) {
+        glDeleteFramebuffers(1, &framebuffer_);
+        framebuffer_ = 0;
+    }
+    if (color_ != 0) {
+        glDeleteTextures(1, &color_);
+        color_ = 0;
+    }
+    if (depth_ != 0) {
+        glDeleteTextures(1, &depth_);
+        depth_ = 0;
+    }
+}
+
+bool RenderTarget::Resize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    if (width <= allocatedWidth_ && height <= allocatedHeight_) {
+        width_ = width;
+        height_ = height;
+        return complete_;
+    }
+
+    // Grow to cover both the old and new size so alternating sizes settle on one allocation.
+    Release();
+    width_ = width;
+    height_ = height;
+    allocatedWidth_ = std::max(width, allocatedWidth_);
+    allocatedHeight_ = std::max(height, allocatedHeight_);
+
+    color_ = CreateAttachment(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, allocatedWidth_, allocatedHeight_);
+    depth_ = CreateAttachment(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, allocatedWidth_, allocatedHeight_);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &framebuffer_);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_, 0);
+    complete_ = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete_) {
+        std::cerr << "Offscreen framebuffer " << allocatedWidth_ << "x" << allocatedHeight_ << " is incomplete\n";
+    }
+    return complete_;
+}
+
+void RenderTarget::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+}
+
+void RenderTarget::BlitToDefault(int x, int y, int width, int height) const {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width_, height_, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+} // namespace ow
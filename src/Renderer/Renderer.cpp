@@ -5,75 +5,608 @@
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Mesh.hpp"
 #include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/ShaderVariants.hpp"
+#include "Engine/Renderer/UniformBlocks.hpp"
 #include "Engine/Scene/Camera.hpp"
-#include "Engine/Scene/Entity.hpp"
 #include "Engine/Scene/Scene.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
 namespace ow {
 
-void Renderer::Render(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings) const {
-    if (height == 0) {
+std::size_t Renderer::BuildStaticBatches(const Scene& scene) {
+    return staticBatches_.Build(scene);
+}
+
+void Renderer::InvalidateStaticBatch(EntityId id) {
+    staticBatches_.Invalidate(id);
+}
+
+namespace {
+
+// View distance mapped onto the full depth field of a draw key; farther draws share the last bucket.
+const float kMaxSortDepth = 200.0f;
+
+// Screen-space error, in pixels, an LOD may introduce at zero bias.
+const float kLodErrorPixels = 1.0f;
+
+// Coarsest level whose error, projected at the nearest point of the world bounding
+// sphere, stays within budget. pixelsPerUnit is at unit distance, already divided by the
+// biased pixel budget.
+int SelectLod(const Mesh& mesh, const Mat4& world, const Vec3& eye, float pixelsPerUnit) {
+    const std::vector<MeshLod>& lods = mesh.Lods();
+    if (lods.empty()) {
+        return 0;
+    }
+    const BoundingSphere local = mesh.LocalSphere();
+    const BoundingSphere sphere = TransformSphere(local, world);
+    const float scale = local.radius > 0.0f ? sphere.radius / local.radius : 1.0f;
+    const float distance = std::max(Length(sphere.center - eye) - sphere.radius, 0.001f);
+    for (std::size_t level = lods.size(); level > 0; --level) {
+        if (lods[level - 1].error * scale * pixelsPerUnit <= distance) {
+            return static_cast<int>(level);
+        }
+    }
+    return 0;
+}
+
+// Auto pre-pass thresholds in fragments per pixel. The gap keeps the mode from flipping
+// every frame while overdraw hovers around one value.
+const float kPrePassEnableOverdraw = 2.0f;
+const float kPrePassDisableOverdraw = 1.5f;
+
+// Small per-frame ids keep draw key fields narrow regardless of pointer values.
+template <typename Map>
+std::uint32_t DenseId(Map& ids, const typename Map::key_type& key) {
+    return ids.emplace(key, static_cast<std::uint32_t>(ids.size())).first->second;
+}
+
+bool HasProgram(const Material& material) {
+    return material.shader || material.shaderVariants;
+}
+
+ShaderFeatureMask FeaturesFor(const Material& material, const RenderSettings& settings) {
+    ShaderFeatureMask features = 0;
+    if (settings.ps2Aesthetic) {
+        features |= kShaderFeaturePs2;
+    }
+    if (material.useAlbedoTexture && material.albedoTextureId != 0) {
+        features |= kShaderFeatureAlbedoTexture;
+    }
+    if (material.useEmissiveTexture && material.emissiveTextureId != 0) {
+        features |= kShaderFeatureEmissiveTexture;
+    }
+    return features;
+}
+
+} // namespace
+
+const Renderer::ShaderBindings& Renderer::BindingsFor(const Shader& shader) {
+    ShaderBindings& b = bindings_[&shader];
+    if (b.revision == shader.Revision()) {
+        return b;
+    }
+
+    b.revision = shader.Revision();
+    shader.BindUniformBlock("FrameBlock", kFrameBlockBinding);
+    shader.BindUniformBlock("MaterialBlock", kMaterialBlockBinding);
+    b.textureAlbedo = shader.Uniform("uTextureAlbedo");
+    b.textureEmissive = shader.Uniform("uTextureEmissive");
+    return b;
+}
+
+void Renderer::Render(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings) {
+    Prepare(scene, camera, width, height, settings);
+    Swap();
+    Submit();
+}
+
+void Renderer::Swap() {
+    if (frames_[back_].ready) {
+        back_ = 1 - back_;
+    }
+}
+
+template <typename Fn>
+void Renderer::ForChunks(std::size_t count, Fn&& fn) {
+    (jobs_ ? *jobs_ : serialJobs_).ParallelFor(count, kChunkSize, std::forward<Fn>(fn));
+}
+
+void Renderer::Prepare(const Scene& scene, const Camera& camera, int width, int height, const RenderSettings& settings) {
+    PreparedFrame& out = frames_[back_];
+    out.ready = false;
+    out.settings = settings;
+    if (width <= 0 || height <= 0) {
         return;
     }
+    ChooseResolution(out, settings, width, height);
+
+    const float aspect = static_cast<float>(out.width) / static_cast<float>(out.height);
+    const Mat4 view = camera.ViewMatrix();
+    const Mat4 projection = camera.ProjectionMatrix(aspect);
+
+    const ComponentPool<Renderable>& renderables = scene.registry.renderables;
+    const Renderable* renderable = renderables.Data();
+    const EntityId* owners = renderables.Owners();
+
+    staticBatches_.Validate(scene);
+
+    // Coarse pass: the scene BVH rejects whole subtrees outside the frustum.
+    const Frustum frustum = camera.ViewFrustum(aspect);
+    candidates_.clear();
+    scene.spatial.QueryFrustum(frustum, [&](EntityId id) {
+        const Renderable* item = renderables.TryGet(id);
+        if (item && item->mesh && item->material && HasProgram(*item->material) && !staticBatches_.IsBatched(id)) {
+            candidates_.push_back(static_cast<std::uint32_t>(item - renderable));
+        }
+        return true;
+    });
+
+    // Fine pass on world-space bounding spheres (BVH leaves are padded AABBs). Each chunk
+    // culls into its own list; concatenating them in chunk order keeps the input order.
+    culler_.Reset(candidates_.size());
+    ForChunks(candidates_.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            const std::uint32_t i = candidates_[c];
+            culler_.Set(c, TransformSphere(renderable[i].mesh->LocalSphere(), scene.hierarchy.WorldMatrix(owners[i])));
+        }
+    });
+
+    chunkVisible_.resize(JobSystem::ChunkCount(candidates_.size(), kChunkSize));
+    ForChunks(candidates_.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        chunkVisible_[chunk].clear();
+        culler_.Cull(frustum, begin, end, chunkVisible_[chunk]);
+    });
+    visible_.clear();
+    for (const std::vector<std::uint32_t>& chunk : chunkVisible_) {
+        visible_.insert(visible_.end(), chunk.begin(), chunk.end());
+    }
+
+    // projection[5] is 1 / tan(fov / 2): pixels per world unit at distance 1.
+    const float lodPixelsPerUnit =
+        projection[5] * static_cast<float>(out.height) * 0.5f / (kLodErrorPixels * std::exp2(settings.lodBias));
+    draws_.resize(visible_.size());
+    ForChunks(visible_.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            const std::uint32_t i = candidates_[visible_[v]];
+            const Mesh& mesh = *renderable[i].mesh;
+            const Mat4& world = scene.hierarchy.WorldMatrix(owners[i]);
+            const int lod = SelectLod(mesh, world, camera.position, lodPixelsPerUnit);
+            draws_[v] = DrawItem{lod > 0 ? mesh.Lods()[static_cast<std::size_t>(lod - 1)].mesh.get() : &mesh,
+                                 renderable[i].material.get(), &world, lod, &renderable[i].mesh,
+                                 &renderable[i].material};
+        }
+    });
+
+    // Static batches hold world-space vertices and are culled as a whole.
+    static const Mat4 kIdentity = Mat4::Identity();
+    for (const StaticBatch& batch : staticBatches_.Batches()) {
+        if (batch.valid && HasProgram(*batch.material) && frustum.Intersects(batch.bounds)) {
+            draws_.push_back(
+                DrawItem{batch.mesh.get(), batch.material.get(), &kIdentity, 0, &batch.mesh, &batch.material});
+        }
+    }
+
+    // Each batch counts as one submitted item in place of its members.
+    RenderStats& stats = out.stats;
+    stats = RenderStats{};
+    stats.submitted = static_cast<int>(renderables.Size() - staticBatches_.BatchedCount() + staticBatches_.ValidCount());
+    stats.visible = static_cast<int>(draws_.size());
+    stats.culled = stats.submitted - stats.visible;
+
+    // Stage every uniform block for the frame; Submit uploads them in one call.
+    out.uniforms.Begin(uniforms_.Alignment());
+
+    FrameUniforms frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.lightDir = Normalize(scene.light.direction);
+    frame.lightColor = scene.light.color;
+    frame.viewPos = camera.position;
+    frame.resolution = Vec2{static_cast<float>(out.width), static_cast<float>(out.height)};
+    frame.ps2Aesthetic = settings.ps2Aesthetic ? 1 : 0;
+    frame.shadeSteps = settings.shadeSteps;
+    frame.ps2Jitter = settings.ps2Jitter;
+    frame.ps2ColorLevels = static_cast<float>(settings.ps2ColorLevels);
+    frame.ps2FogStrength = settings.ps2FogStrength;
+    out.frameOffset = out.uniforms.Push(&frame, sizeof(frame));
+
+    // Dense ids and material blocks go through shared maps, so this pass stays serial and
+    // leaves the depth field of each key zero. Submit emptied materialStates and meshes.
+    out.materialStates.clear();
+    sourceIds_.clear();
+    programIds_.clear();
+    materialIds_.clear();
+    meshIds_.clear();
+    queue_.Resize(draws_.size());
+    for (std::size_t d = 0; d < draws_.size(); ++d) {
+        const DrawItem& draw = draws_[d];
+        const Material& material = *draw.material;
+        if (draw.lod > 0) {
+            ++stats.lodDraws;
+        }
+
+        auto found = out.materialStates.find(&material);
+        if (found == out.materialStates.end()) {
+            MaterialUniforms block;
+            block.color = material.color;
+            block.roughness = material.roughness;
+            block.emissiveColor = material.emissiveColor;
+            block.emissiveStrength = material.emissiveStrength;
+            block.useAlbedoTexture = material.useAlbedoTexture ? 1 : 0;
+            block.useEmissiveTexture = material.useEmissiveTexture ? 1 : 0;
+
+            // Variants are keyed by (source, feature mask); a variant that is not finished
+            // yet is resolved in Submit, on the GL thread.
+            MaterialState state;
+            state.material = *draw.materialOwner;
+            state.uniformOffset = out.uniforms.Push(&block, sizeof(block));
+            const void* source = material.shader.get();
+            if (material.shaderVariants) {
+                state.variants = material.shaderVariants.get();
+                state.features = FeaturesFor(material, settings);
+                state.shader = state.variants->Find(state.features);
+                state.resolvedFeatures = state.features;
+                source = state.variants;
+            } else {
+                state.shader = material.shader.get();
+            }
+            const std::uint64_t program = (static_cast<std::uint64_t>(DenseId(sourceIds_, source)) << 32) | state.features;
+            state.shaderId = DenseId(programIds_, program);
+            found = out.materialStates.emplace(&material, std::move(state)).first;
+        }
+
+        queue_[d] = RenderQueue::Item{DrawKey::Make(RenderPass::Opaque,
+                                                    found->second.shaderId,
+                                                    DenseId(materialIds_, &material),
+                                                    DenseId(meshIds_, draw.mesh),
+                                                    0),
+                                      static_cast<std::uint32_t>(d)};
+    }
+
+    ForChunks(draws_.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t d = begin; d < end; ++d) {
+            const Mat4& m = *draws_[d].model;
+            const float depth = -(view[2] * m[12] + view[6] * m[13] + view[10] * m[14] + view[14]);
+            queue_[d].key |= DrawKey::QuantizeDepth(depth, kMaxSortDepth);
+        }
+    });
+    queue_.Sort();
+
+    // Saturated ids (see DrawKey) still sort, but their keys may alias; say so once.
+    const bool overflow = programIds_.size() > DrawKey::kMaxShader || materialIds_.size() > DrawKey::kMaxMaterial ||
+                          meshIds_.size() > DrawKey::kMaxMesh;
+    if (overflow && !keyOverflowReported_) {
+        keyOverflowReported_ = true;
+        std::cerr << "Renderer: " << programIds_.size() << " programs, " << materialIds_.size() << " materials, "
+                  << meshIds_.size() << " meshes in one frame exceed the draw key fields; sorting degrades\n";
+    }
+
+    // Consecutive draws with the same material (and so the same program) and mesh become
+    // one instanced draw, resolved here to everything Submit needs. Sorting makes them
+    // adjacent; the pointers, not the keys, decide, since saturated ids can alias.
+    // Instances are written in sorted order so each group is a contiguous range of the
+    // instance buffer.
+    const std::vector<RenderQueue::Item>& items = queue_.Items();
+    out.groups.clear();
+    out.commands.clear();
+    out.meshes.clear();
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        const DrawItem& draw = draws_[items[k].payload];
+        if (!out.groups.empty()) {
+            const DrawItem& first = draws_[items[out.commands.back().baseInstance].payload];
+            if (draw.material == first.material && draw.mesh == first.mesh) {
+                ++out.commands.back().instanceCount;
+                continue;
+            }
+        }
+
+        const MeshAllocation& geometry = draw.mesh->Allocation();
+        DrawGroup group;
+        group.material = draw.material;
+        group.state = &out.materialStates[draw.material];
+        group.vao = draw.mesh->VertexArray();
+        group.indexType = draw.mesh->IndexType();
+        group.indexOffset = geometry.indexOffset;
+        out.groups.push_back(group);
+        if (out.meshes.empty() || out.meshes.back() != *draw.meshOwner) {
+            out.meshes.push_back(*draw.meshOwner);
+        }
+
+        DrawElementsIndirectCommand command;
+        command.count = geometry.indexCount;
+        command.instanceCount = 1;
+        command.firstIndex = static_cast<std::uint32_t>(geometry.indexOffset / geometry.indexSize);
+        command.baseVertex = geometry.baseVertex;
+        command.baseInstance = static_cast<std::uint32_t>(k);
+        out.commands.push_back(command);
+    }
+    // Batch meshes dropped by Validate or Invalidate ride along so Submit releases them on
+    // the GL thread; their destructors delete GL objects and touch the arena free lists.
+    staticBatches_.TakeReleased(out.meshes);
+
+    out.instances.resize(items.size());
+    ForChunks(items.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            InstanceData& instance = out.instances[k];
+            const DrawItem& draw = draws_[items[k].payload];
+            // Packed meshes store bounds-relative positions; the decode rides on the model
+            // matrix while normals only see the world transform.
+            instance.normalMatrix = Mat4::NormalMatrix(*draw.model);
+            instance.model = draw.mesh->Format() == VertexFormat::Packed ? *draw.model * draw.mesh->DecodeMatrix() : *draw.model;
+        }
+    });
+    out.ready = true;
+}
+
+void Renderer::Submit() {
+    PreparedFrame& frame = frames_[1 - back_];
+    if (!frame.ready) {
+        return;
+    }
+    frame.ready = false;
+    const RenderSettings& settings = frame.settings;
+    stats_ = frame.stats;
+    GpuScope sceneScope(profiler_, "SCENE");
+
+    // Without a usable offscreen target the scene is drawn straight into the present
+    // rectangle at window resolution; the aspect ratio is the same either way.
+    const bool offscreen = frame.offscreen && target_.Resize(frame.width, frame.height);
+    if (offscreen) {
+        target_.Bind();
+        glViewport(0, 0, frame.width, frame.height);
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(frame.presentX, frame.presentY, frame.presentWidth, frame.presentHeight);
+    }
+    stats_.renderWidth = offscreen ? frame.width : frame.presentWidth;
+    stats_.renderHeight = offscreen ? frame.height : frame.presentHeight;
 
     glPolygonMode(GL_FRONT_AND_BACK, settings.wireframe ? GL_LINE : GL_FILL);
 
-    glViewport(0, 0, width, height);
     if (settings.ps2Aesthetic) {
         glClearColor(0.43f, 0.50f, 0.56f, 1.0f);
     } else {
         glClearColor(0.72f, 0.78f, 0.86f, 1.0f);
     }
+    // A target larger than the frame (it only grows) is cleared just where it is used.
+    const bool scissor = offscreen && (frame.width < target_.AllocatedWidth() || frame.height < target_.AllocatedHeight());
+    if (scissor) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(0, 0, frame.width, frame.height);
+    }
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (scissor) {
+        glDisable(GL_SCISSOR_TEST);
+    }
 
-    const float aspect = static_cast<float>(width) / static_cast<float>(height);
-    const Mat4 view = camera.ViewMatrix();
-    const Mat4 projection = camera.ProjectionMatrix(aspect);
+    {
+        GpuScope uploadScope(profiler_, "UPLOAD");
+        uniforms_.Upload(frame.uniforms);
+        uniforms_.Bind(kFrameBlockBinding, frame.frameOffset, sizeof(FrameUniforms));
+        instanceBuffer_.Upload(frame.instances);
+    }
 
-    for (const auto& entity : scene.entities) {
-        if (!entity || !entity->mesh || !entity->material || !entity->material->shader) {
-            continue;
+    if (indirectSupport_ < 0) {
+        indirectSupport_ = IndirectBuffer::Supported() ? 1 : 0;
+    }
+    stats_.indirectSupported = indirectSupport_ == 1;
+    stats_.indirect = settings.multiDrawIndirect && stats_.indirectSupported;
+    if (stats_.indirect) {
+        indirectBuffer_.Upload(frame.commands);
+    }
+
+    // Overdraw is measured on whichever pass writes depth; wireframe lines would skew it.
+    const bool measure = !settings.wireframe;
+    const int pixels = stats_.renderWidth * stats_.renderHeight;
+    stats_.depthPrePass = UseDepthPrePass(settings);
+    stats_.drawCalls = 0;
+
+    // Submit in key order; the tracker drops binds that match the previous draw.
+    if (stats_.depthPrePass) {
+        GpuScope depthScope(profiler_, "DEPTH");
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        if (measure) {
+            overdraw_.Begin();
+        }
+        state_.Reset();
+        boundMaterial_ = nullptr;
+        stats_.drawCalls += stats_.indirect ? SubmitIndirect(frame, true) : SubmitGroups(frame, true);
+        if (measure) {
+            overdraw_.End(pixels);
+        }
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+    {
+        GpuScope drawScope(profiler_, "DRAW");
+        const bool measureDraw = measure && !stats_.depthPrePass;
+        if (measureDraw) {
+            overdraw_.Begin();
+        }
+        state_.Reset();
+        boundMaterial_ = nullptr;
+        stats_.drawCalls += stats_.indirect ? SubmitIndirect(frame, false) : SubmitGroups(frame, false);
+        if (measureDraw) {
+            overdraw_.End(pixels);
         }
+    }
+    if (stats_.depthPrePass) {
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
+    stats_.overdraw = overdraw_.Overdraw();
 
-        auto& material = *entity->material;
-        auto& shader = *material.shader;
-
-        shader.Use();
-        shader.SetMat4("uModel", entity->transform.Matrix());
-        shader.SetMat4("uView", view);
-        shader.SetMat4("uProjection", projection);
-        shader.SetVec3("uLightDir", Normalize(scene.light.direction));
-        shader.SetVec3("uLightColor", scene.light.color);
-        shader.SetVec3("uViewPos", camera.position);
-        shader.SetVec3("uColor", material.color);
-        shader.SetVec3("uEmissiveColor", material.emissiveColor);
-        shader.SetInt("uUseAlbedoTexture", material.useAlbedoTexture ? 1 : 0);
-        shader.SetInt("uUseEmissiveTexture", material.useEmissiveTexture ? 1 : 0);
-        shader.SetInt("uTextureAlbedo", 0);
-        shader.SetInt("uTextureEmissive", 1);
-        shader.SetFloat("uRoughness", material.roughness);
-        shader.SetFloat("uEmissiveStrength", material.emissiveStrength);
-        shader.SetInt("uShadeSteps", settings.shadeSteps);
-        shader.SetVec2("uResolution", Vec2{static_cast<float>(width), static_cast<float>(height)});
-        shader.SetInt("uPs2Aesthetic", settings.ps2Aesthetic ? 1 : 0);
-        shader.SetFloat("uPs2Jitter", settings.ps2Jitter);
-        shader.SetFloat("uPs2ColorLevels", static_cast<float>(settings.ps2ColorLevels));
-        shader.SetFloat("uPs2FogStrength", settings.ps2FogStrength);
+    state_.BindVertexArray(0);
+    uniforms_.EndFrame();
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        if (material.useAlbedoTexture && material.albedoTextureId != 0) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, material.albedoTextureId);
+    if (offscreen) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (frame.presentWidth != frame.windowWidth || frame.presentHeight != frame.windowHeight) {
+            glViewport(0, 0, frame.windowWidth, frame.windowHeight);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        bool presented = false;
+        if (post_.Active(settings)) {
+            GpuScope postScope(profiler_, "POST");
+            presented = post_.Apply(target_, settings, frame.presentX, frame.presentY, frame.presentWidth, frame.presentHeight);
+        }
+        if (!presented) {
+            GpuScope upscaleScope(profiler_, "UPSCALE");
+            target_.BlitToDefault(frame.presentX, frame.presentY, frame.presentWidth, frame.presentHeight);
+        }
+    }
+    // Overlays drawn after the scene expect the whole window.
+    glViewport(0, 0, frame.windowWidth, frame.windowHeight);
+
+    // The frame may hold the last references to meshes and materials, whose destructors
+    // need the GL context, so they are dropped here rather than by the next Prepare.
+    frame.materialStates.clear();
+    frame.meshes.clear();
+}
+
+void Renderer::ChooseResolution(PreparedFrame& frame, const RenderSettings& settings, int width, int height) const {
+    frame.windowWidth = width;
+    frame.windowHeight = height;
+    frame.width = width;
+    frame.height = height;
+    if (settings.resolutionMode == ResolutionMode::Scaled || settings.resolutionMode == ResolutionMode::Dynamic) {
+        const float scale = std::clamp(settings.resolutionScale, 0.1f, 1.0f);
+        frame.width = std::max(1, static_cast<int>(std::lround(static_cast<float>(width) * scale)));
+        frame.height = std::max(1, static_cast<int>(std::lround(static_cast<float>(height) * scale)));
+    } else if (settings.resolutionMode == ResolutionMode::Fixed) {
+        frame.width = std::max(1, settings.fixedWidth);
+        frame.height = std::max(1, settings.fixedHeight);
+    }
+    frame.offscreen = frame.width != width || frame.height != height || post_.Active(settings);
+
+    // Scaled and Dynamic keep the window's aspect and fill it; Fixed gets the largest centred
+    // rectangle of its own aspect (pillarboxed or letterboxed).
+    frame.presentX = 0;
+    frame.presentY = 0;
+    frame.presentWidth = width;
+    frame.presentHeight = height;
+    if (settings.resolutionMode == ResolutionMode::Fixed) {
+        const long long fitHeight = static_cast<long long>(width) * frame.height / frame.width;
+        if (fitHeight <= height) {
+            frame.presentHeight = static_cast<int>(fitHeight);
+        } else {
+            frame.presentWidth = static_cast<int>(static_cast<long long>(height) * frame.width / frame.height);
         }
+        frame.presentX = (width - frame.presentWidth) / 2;
+        frame.presentY = (height - frame.presentHeight) / 2;
+    }
+}
+
+bool Renderer::UseDepthPrePass(const RenderSettings& settings) {
+    if (settings.wireframe || settings.depthPrePass == DepthPrePassMode::Off) {
+        return false;
+    }
+    if (settings.depthPrePass == DepthPrePassMode::On) {
+        return true;
+    }
+
+    const float overdraw = overdraw_.Overdraw();
+    if (!autoPrePass_ && overdraw > kPrePassEnableOverdraw) {
+        autoPrePass_ = true;
+    } else if (autoPrePass_ && overdraw < kPrePassDisableOverdraw) {
+        autoPrePass_ = false;
+    }
+    return autoPrePass_;
+}
+
+bool Renderer::BindDrawState(const DrawGroup& group, bool depthOnly) {
+    MaterialState& state = *group.state;
+    if (!state.shader && state.variants) {
+        // Never blocks: a variant still compiling is stood in for by a ready subset.
+        state.shader = state.variants->Resolve(state.features, &state.resolvedFeatures);
+    }
+    if (!state.shader) {
+        return false;
+    }
+
+    if (depthOnly && !state.depthShader) {
+        // GL_EQUAL in the shading pass needs identical depth, so the depth variant keeps
+        // the vertex-stage features of the program it stands in front of. Until it has
+        // compiled, the shading program itself writes depth with colour masked off.
+        const ShaderFeatureMask depthFeatures = (state.resolvedFeatures & kShaderFeaturePs2) | kShaderFeatureDepthOnly;
+        const Shader* depthShader = state.variants ? state.variants->Poll(depthFeatures) : nullptr;
+        state.depthShader = depthShader ? depthShader : state.shader;
+    }
 
+    const Shader& shader = depthOnly ? *state.depthShader : *state.shader;
+    if (state_.UseProgram(shader.Id())) {
+        const ShaderBindings& u = BindingsFor(shader);
+        shader.SetInt(u.textureAlbedo, 0);
+        shader.SetInt(u.textureEmissive, 1);
+    }
+    if (depthOnly) {
+        return true;
+    }
+
+    const Material& material = *group.material;
+    if (&material != boundMaterial_) {
+        uniforms_.Bind(kMaterialBlockBinding, state.uniformOffset, sizeof(MaterialUniforms));
+        if (material.useAlbedoTexture && material.albedoTextureId != 0) {
+            state_.BindTexture2D(0, material.albedoTextureId);
+        }
         if (material.useEmissiveTexture && material.emissiveTextureId != 0) {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, material.emissiveTextureId);
+            state_.BindTexture2D(1, material.emissiveTextureId);
         }
+        boundMaterial_ = &material;
+    }
+    return true;
+}
 
-        entity->mesh->Draw();
+int Renderer::SubmitGroups(const PreparedFrame& frame, bool depthOnly) {
+    int calls = 0;
+    for (std::size_t i = 0; i < frame.groups.size(); ++i) {
+        const DrawGroup& group = frame.groups[i];
+        const DrawElementsIndirectCommand& command = frame.commands[i];
+        if (!BindDrawState(group, depthOnly)) {
+            continue;
+        }
+
+        state_.BindVertexArray(group.vao);
+        instanceBuffer_.Bind(command.baseInstance);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.count), group.indexType,
+                                          reinterpret_cast<void*>(group.indexOffset),
+                                          static_cast<GLsizei>(command.instanceCount), command.baseVertex);
+        ++calls;
     }
+    return calls;
+}
 
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+int Renderer::SubmitIndirect(const PreparedFrame& frame, bool depthOnly) {
+    const std::vector<DrawGroup>& groups = frame.groups;
+    // Groups only need their own call where shader, material, VAO or index type changes;
+    // meshes within a run differ by command offsets alone.
+    int calls = 0;
+    std::size_t first = 0;
+    while (first < groups.size()) {
+        const DrawGroup& group = groups[first];
+        std::size_t last = first + 1;
+        while (last < groups.size() && groups[last].material == group.material &&
+               groups[last].vao == group.vao && groups[last].indexType == group.indexType) {
+            ++last;
+        }
+
+        if (BindDrawState(group, depthOnly)) {
+            if (state_.BindVertexArray(group.vao)) {
+                instanceBuffer_.Bind(0);
+            }
+            indirectBuffer_.Draw(group.indexType, first, last - first);
+            ++calls;
+        }
+        first = last;
+    }
+    return calls;
 }
 
 } // namespace ow
@@ -1,7 +1,12 @@
 #include "Engine/Renderer/Shader.hpp"
 
 #include "Engine/Renderer/GL.hpp"
+#include "Engine/Renderer/ProgramCache.hpp"
 
+#include <SDL.h>
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace ow {
@@ -34,82 +39,245 @@ bool CheckProgram(unsigned int program) {
     return false;
 }
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+std::uint32_t NextRevision() {
+    static std::uint32_t revision = 0;
+    return ++revision;
+}
+
 } // namespace
 
+bool Shader::ParallelCompileSupported() {
+    // Also asks the driver for as many compiler threads as it wants.
+    static const bool supported = [] {
+        if (!HasGLExtension("GL_KHR_parallel_shader_compile")) {
+            return false;
+        }
+        using MaxThreadsFn = void(APIENTRY*)(GLuint);
+        auto maxThreads = reinterpret_cast<MaxThreadsFn>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        if (maxThreads) {
+            maxThreads(0xFFFFFFFFu);
+        }
+        return true;
+    }();
+    return supported;
+}
+
 Shader::~Shader() {
+    DiscardPending();
     if (programId_ != 0) {
         glDeleteProgram(programId_);
     }
 }
 
 bool Shader::Compile(const std::string& vertexSource, const std::string& fragmentSource) {
+    return BeginCompile(vertexSource, fragmentSource) && FinishCompile();
+}
+
+bool Shader::BeginCompile(const std::string& vertexSource, const std::string& fragmentSource) {
+    DiscardPending();
+
+    ProgramCache* cache = programCache_ && programCache_->IsOpen() ? programCache_ : nullptr;
+    if (cache) {
+        pendingKey_ = cache->Key(vertexSource, fragmentSource);
+        const unsigned int program = glCreateProgram();
+        if (cache->Load(pendingKey_, program)) {
+            pendingProgram_ = program;
+            return true;
+        }
+        glDeleteProgram(program);
+    }
+
     const char* vertexSrc = vertexSource.c_str();
     const char* fragmentSrc = fragmentSource.c_str();
 
-    const unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSrc, nullptr);
-    glCompileShader(vertexShader);
-    if (!CheckShader(vertexShader, "vertex")) {
-        glDeleteShader(vertexShader);
-        return false;
+    pendingVertex_ = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(pendingVertex_, 1, &vertexSrc, nullptr);
+    glCompileShader(pendingVertex_);
+
+    pendingFragment_ = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(pendingFragment_, 1, &fragmentSrc, nullptr);
+    glCompileShader(pendingFragment_);
+
+    // Linking right away (instead of after checking each stage) keeps the whole pipeline
+    // on the driver's threads; stage errors are reported from FinishCompile.
+    pendingProgram_ = glCreateProgram();
+    glAttachShader(pendingProgram_, pendingVertex_);
+    glAttachShader(pendingProgram_, pendingFragment_);
+    if (cache) {
+        glProgramParameteri(pendingProgram_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
+    glLinkProgram(pendingProgram_);
+    return true;
+}
 
-    const unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSrc, nullptr);
-    glCompileShader(fragmentShader);
-    if (!CheckShader(fragmentShader, "fragment")) {
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        return false;
+bool Shader::IsReady() const {
+    if (pendingProgram_ == 0 || !ParallelCompileSupported()) {
+        return true;
     }
+    int done = 0;
+    glGetProgramiv(pendingProgram_, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
 
-    const unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
+bool Shader::FinishCompile() {
+    if (pendingProgram_ == 0) {
+        return false;
+    }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    const bool fromSource = pendingVertex_ != 0;
+    bool ok = true;
+    if (fromSource) {
+        ok = CheckShader(pendingVertex_, "vertex") && CheckShader(pendingFragment_, "fragment");
+    }
+    ok = ok && CheckProgram(pendingProgram_);
 
-    if (!CheckProgram(program)) {
-        glDeleteProgram(program);
+    const unsigned int program = pendingProgram_;
+    if (!ok) {
+        DiscardPending();
         return false;
     }
 
+    if (fromSource && programCache_ && programCache_->IsOpen()) {
+        programCache_->Store(pendingKey_, program);
+    }
+    glDeleteShader(pendingVertex_);
+    glDeleteShader(pendingFragment_);
+    pendingVertex_ = 0;
+    pendingFragment_ = 0;
+    pendingProgram_ = 0;
+
     if (programId_ != 0) {
         glDeleteProgram(programId_);
     }
     programId_ = program;
+    revision_ = NextRevision();
+    ReflectUniforms();
     return true;
 }
 
+void Shader::DiscardPending() {
+    if (pendingVertex_ != 0) {
+        glDeleteShader(pendingVertex_);
+    }
+    if (pendingFragment_ != 0) {
+        glDeleteShader(pendingFragment_);
+    }
+    if (pendingProgram_ != 0) {
+        glDeleteProgram(pendingProgram_);
+    }
+    pendingVertex_ = 0;
+    pendingFragment_ = 0;
+    pendingProgram_ = 0;
+}
+
+void Shader::ReflectUniforms() {
+    uniforms_.clear();
+    slots_.clear();
+
+    int count = 0;
+    int maxLength = 0;
+    glGetProgramiv(programId_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(programId_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(static_cast<std::size_t>(std::max(maxLength, 1)), '\0');
+    for (int i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programId_, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, &name[0]);
+
+        std::string uniformName = name.substr(0, static_cast<std::size_t>(length));
+        // Arrays report "name[0]"; register them under the plain name.
+        const std::size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            uniformName.resize(bracket);
+        }
+
+        UniformSlot slot;
+        slot.location = glGetUniformLocation(programId_, uniformName.c_str());
+        slot.type = type;
+        if (slot.location < 0) {
+            // Block members have no location; they are fed through buffers instead.
+            continue;
+        }
+
+        slots_.emplace(uniformName, static_cast<int>(uniforms_.size()));
+        uniforms_.push_back(slot);
+    }
+}
+
 void Shader::Use() const {
     glUseProgram(programId_);
 }
 
-void Shader::SetMat4(const char* name, const Mat4& value) const {
-    const int location = glGetUniformLocation(programId_, name);
-    glUniformMatrix4fv(location, 1, GL_FALSE, value.m);
+UniformHandle Shader::Uniform(const char* name) const {
+    const auto it = slots_.find(name);
+    return it != slots_.end() ? UniformHandle{it->second} : UniformHandle{};
 }
 
-void Shader::SetVec2(const char* name, const Vec2& value) const {
-    const int location = glGetUniformLocation(programId_, name);
-    glUniform2f(location, value.x, value.y);
+bool Shader::BindUniformBlock(const char* name, unsigned int binding) const {
+    const unsigned int index = glGetUniformBlockIndex(programId_, name);
+    if (index == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(programId_, index, binding);
+    return true;
 }
 
-void Shader::SetVec3(const char* name, const Vec3& value) const {
-    const int location = glGetUniformLocation(programId_, name);
-    glUniform3f(location, value.x, value.y, value.z);
+bool Shader::UpdateCache(UniformHandle handle, const void* data, std::size_t bytes) const {
+    if (!handle.IsValid()) {
+        return false;
+    }
+
+    UniformSlot& slot = uniforms_[static_cast<std::size_t>(handle.slot)];
+    if (slot.hasValue && std::memcmp(slot.value, data, bytes) == 0) {
+        return false;
+    }
+    std::memcpy(slot.value, data, bytes);
+    slot.hasValue = true;
+    return true;
+}
+
+void Shader::SetMat4(UniformHandle handle, const Mat4& value) const {
+    if (UpdateCache(handle, value.m, sizeof(value.m))) {
+        glUniformMatrix4fv(uniforms_[static_cast<std::size_t>(handle.slot)].location, 1, GL_FALSE, value.m);
+    }
 }
 
-void Shader::SetInt(const char* name, int value) const {
-    const int location = glGetUniformLocation(programId_, name);
-    glUniform1i(location, value);
+void Shader::SetMat3(UniformHandle handle, const Mat3& value) const {
+    if (UpdateCache(handle, value.m, sizeof(value.m))) {
+        glUniformMatrix3fv(uniforms_[static_cast<std::size_t>(handle.slot)].location, 1, GL_FALSE, value.m);
+    }
+}
+
+void Shader::SetVec2(UniformHandle handle, const Vec2& value) const {
+    const float data[2] = {value.x, value.y};
+    if (UpdateCache(handle, data, sizeof(data))) {
+        glUniform2f(uniforms_[static_cast<std::size_t>(handle.slot)].location, value.x, value.y);
+    }
 }
 
-void Shader::SetFloat(const char* name, float value) const {
-    const int location = glGetUniformLocation(programId_, name);
-    glUniform1f(location, value);
+void Shader::SetVec3(UniformHandle handle, const Vec3& value) const {
+    const float data[3] = {value.x, value.y, value.z};
+    if (UpdateCache(handle, data, sizeof(data))) {
+        glUniform3f(uniforms_[static_cast<std::size_t>(handle.slot)].location, value.x, value.y, value.z);
+    }
+}
+
+void Shader::SetInt(UniformHandle handle, int value) const {
+    if (UpdateCache(handle, &value, sizeof(value))) {
+        glUniform1i(uniforms_[static_cast<std::size_t>(handle.slot)].location, value);
+    }
+}
+
+void Shader::SetFloat(UniformHandle handle, float value) const {
+    if (UpdateCache(handle, &value, sizeof(value))) {
+        glUniform1f(uniforms_[static_cast<std::size_t>(handle.slot)].location, value);
+    }
 }
 
 } // namespace ow
@@ -0,0 +1,166 @@
+#include "Engine/Renderer/ShaderVariants.hpp"
+
+#include "Engine/Renderer/Shader.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace ow {
+
+namespace {
+
+struct FeatureDefine {
+    ShaderFeature feature;
+    const char* name;
+};
+
+constexpr FeatureDefine kFeatureDefines[] = {
+    {kShaderFeaturePs2, "OW_PS2"},
+    {kShaderFeatureAlbedoTexture, "OW_ALBEDO_TEXTURE"},
+    {kShaderFeatureEmissiveTexture, "OW_EMISSIVE_TEXTURE"},
+    {kShaderFeatureDepthOnly, "OW_DEPTH_ONLY"},
+};
+
+} // namespace
+
+ShaderVariants::ShaderVariants(std::string vertexSource, std::string fragmentSource)
+    : vertexSource_(std::move(vertexSource)), fragmentSource_(std::move(fragmentSource)) {}
+
+std::shared_ptr<Shader> ShaderVariants::Get(ShaderFeatureMask features) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RequestLocked(features);
+    std::shared_ptr<Shader>& shader = programs_[features];
+    if (shader && shader->IsPending()) {
+        Finish(shader, features);
+    }
+    return shader;
+}
+
+void ShaderVariants::Request(ShaderFeatureMask features) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RequestLocked(features);
+}
+
+void ShaderVariants::RequestLocked(ShaderFeatureMask features) {
+    if (programs_.find(features) != programs_.end()) {
+        return;
+    }
+
+    auto shader = std::make_shared<Shader>();
+    if (!shader->BeginCompile(Specialize(vertexSource_, features), Specialize(fragmentSource_, features))) {
+        std::cerr << "Shader variant 0x" << std::hex << features << std::dec << " failed to compile\n";
+        shader.reset();
+    }
+    programs_.emplace(features, std::move(shader));
+}
+
+const Shader* ShaderVariants::Poll(ShaderFeatureMask features) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return PollLocked(features);
+}
+
+const Shader* ShaderVariants::PollLocked(ShaderFeatureMask features) {
+    RequestLocked(features);
+    std::shared_ptr<Shader>& shader = programs_[features];
+    if (shader && shader->IsPending() && shader->IsReady()) {
+        Finish(shader, features);
+    }
+    return shader && !shader->IsPending() ? shader.get() : nullptr;
+}
+
+const Shader* ShaderVariants::Resolve(ShaderFeatureMask features, ShaderFeatureMask* resolved) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const Shader* exact = PollLocked(features)) {
+        if (resolved) {
+            *resolved = features;
+        }
+        return exact;
+    }
+
+    // Stand in with the finished variant sharing the most requested features (never one
+    // with extra features, which could sample unbound textures).
+    const Shader* best = nullptr;
+    ShaderFeatureMask bestMask = 0;
+    int bestCount = -1;
+    for (const auto& [mask, candidate] : programs_) {
+        if ((mask & ~features) != 0 || !candidate || candidate->IsPending()) {
+            continue;
+        }
+        int count = 0;
+        for (ShaderFeatureMask bits = mask; bits != 0; bits &= bits - 1) {
+            ++count;
+        }
+        if (count > bestCount) {
+            best = candidate.get();
+            bestMask = mask;
+            bestCount = count;
+        }
+    }
+    if (best && resolved) {
+        *resolved = bestMask;
+    }
+    return best;
+}
+
+const Shader* ShaderVariants::Find(ShaderFeatureMask features) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = programs_.find(features);
+    return found != programs_.end() && found->second && !found->second->IsPending() ? found->second.get() : nullptr;
+}
+
+std::size_t ShaderVariants::VariantCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return programs_.size();
+}
+
+std::size_t ShaderVariants::PendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t pending = 0;
+    for (const auto& entry : programs_) {
+        if (entry.second && entry.second->IsPending()) {
+            ++pending;
+        }
+    }
+    return pending;
+}
+
+bool ShaderVariants::Finish(std::shared_ptr<Shader>& shader, ShaderFeatureMask features) {
+    if (shader->FinishCompile()) {
+        return true;
+    }
+    std::cerr << "Shader variant 0x" << std::hex << features << std::dec << " failed to compile\n";
+    shader.reset();
+    return false;
+}
+
+std::string ShaderVariants::Specialize(const std::string& source, ShaderFeatureMask features) {
+    std::string defines;
+    for (const FeatureDefine& define : kFeatureDefines) {
+        if ((features & define.feature) != 0) {
+            defines += "#define ";
+            defines += define.name;
+            defines += " 1\n";
+        }
+    }
+    if (defines.empty()) {
+        return source;
+    }
+
+    // #version must stay the first directive, so the defines go on the line after it.
+    std::size_t insertAt = 0;
+    const std::size_t version = source.find("#version");
+    if (version != std::string::npos) {
+        const std::size_t lineEnd = source.find('\n', version);
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+
+    std::string specialized = source;
+    if (insertAt == specialized.size() && !specialized.empty() && specialized.back() != '\n') {
+        specialized += '\n';
+        ++insertAt;
+    }
+    specialized.insert(insertAt, defines);
+    return specialized;
+}
+
+} // namespace ow
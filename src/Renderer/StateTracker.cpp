@@ -0,0 +1,57 @@
+#include "Engine/Renderer/StateTracker.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+namespace ow {
+
+void StateTracker::Reset() {
+    program_ = kUnknown;
+    vao_ = kUnknown;
+    activeUnit_ = -1;
+    for (unsigned int& texture : textures_) {
+        texture = kUnknown;
+    }
+    skipped_ = 0;
+}
+
+bool StateTracker::UseProgram(unsigned int program) {
+    if (program == program_) {
+        ++skipped_;
+        return false;
+    }
+    glUseProgram(program);
+    program_ = program;
+    return true;
+}
+
+bool StateTracker::BindVertexArray(unsigned int vao) {
+    if (vao == vao_) {
+        ++skipped_;
+        return false;
+    }
+    glBindVertexArray(vao);
+    vao_ = vao;
+    return true;
+}
+
+bool StateTracker::BindTexture2D(int unit, unsigned int texture) {
+    if (unit < 0 || unit >= kTextureUnits) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<unsigned int>(unit));
+        glBindTexture(GL_TEXTURE_2D, texture);
+        activeUnit_ = unit;
+        return true;
+    }
+    if (textures_[unit] == texture) {
+        ++skipped_;
+        return false;
+    }
+    if (activeUnit_ != unit) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<unsigned int>(unit));
+        activeUnit_ = unit;
+    }
+    glBindTexture(GL_TEXTURE_2D, texture);
+    textures_[unit] = texture;
+    return true;
+}
+
+} // namespace ow
@@ -0,0 +1,179 @@
+#include "Engine/Renderer/StaticBatcher.hpp"
+
+#include <unordered_map>
+
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Scene/Scene.hpp"
+
+namespace ow {
+
+namespace {
+
+struct PendingBatch {
+    std::shared_ptr<Material> material;
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<EntityId> members;
+};
+
+Vec3 TransformPoint(const Mat4& m, const Vec3& p) {
+    return Vec3{
+        m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+        m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+        m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14],
+    };
+}
+
+Vec3 TransformNormal(const Mat3& n, const Vec3& v) {
+    return Normalize(Vec3{
+        n[0] * v.x + n[3] * v.y + n[6] * v.z,
+        n[1] * v.x + n[4] * v.y + n[7] * v.z,
+        n[2] * v.x + n[5] * v.y + n[8] * v.z,
+    });
+}
+
+} // namespace
+
+std::size_t StaticBatcher::Build(const Scene& scene, std::size_t maxVertices) {
+    Clear();
+
+    const Registry& registry = scene.registry;
+    const Renderable* renderables = registry.renderables.Data();
+    const EntityId* owners = registry.renderables.Owners();
+
+    // Open batch per material; a full batch is flushed and a new one started.
+    std::vector<PendingBatch> finished;
+    std::unordered_map<const Material*, PendingBatch> open;
+
+    for (std::size_t i = 0; i < registry.renderables.Size(); ++i) {
+        const Renderable& item = renderables[i];
+        const EntityId id = owners[i];
+        const Rigidbody* rigidbody = registry.rigidbodies.TryGet(id);
+        if (!item.mesh || !item.material || !rigidbody || !rigidbody->isStatic || scene.hierarchy.Parent(id).IsValid()) {
+            continue;
+        }
+
+        const std::vector<Vertex>& source = item.mesh->Vertices();
+        const std::vector<unsigned int>& sourceIndices = item.mesh->Indices();
+        if (source.empty() || source.size() > maxVertices) {
+            continue;
+        }
+
+        PendingBatch& batch = open[item.material.get()];
+        if (batch.vertices.size() + source.size() > maxVertices) {
+            finished.push_back(std::move(batch));
+            batch = PendingBatch{};
+        }
+        batch.material = item.material;
+
+        const Mat4& world = scene.hierarchy.WorldMatrix(id);
+        const Mat3 normalMatrix = Mat4::NormalMatrix(world);
+        const unsigned int base = static_cast<unsigned int>(batch.vertices.size());
+        for (const Vertex& v : source) {
+            batch.vertices.push_back(Vertex{TransformPoint(world, v.position), TransformNormal(normalMatrix, v.normal), v.uv});
+        }
+        for (unsigned int index : sourceIndices) {
+            batch.indices.push_back(base + index);
+        }
+        batch.members.push_back(id);
+    }
+
+    for (auto& entry : open) {
+        if (!entry.second.members.empty()) {
+            finished.push_back(std::move(entry.second));
+        }
+    }
+
+    batchOf_.assign(registry.Capacity(), Membership{});
+    for (PendingBatch& pending : finished) {
+        // A single member gains nothing from batching.
+        if (pending.members.size() < 2) {
+            continue;
+        }
+
+        StaticBatch batch;
+        batch.material = std::move(pending.material);
+        batch.mesh = std::make_shared<Mesh>(pending.vertices, pending.indices);
+        batch.bounds = batch.mesh->LocalBounds();
+        batch.members = std::move(pending.members);
+
+        for (EntityId member : batch.members) {
+            batchOf_[member.index] = Membership{member, static_cast<int>(batches_.size())};
+        }
+        batchedCount_ += batch.members.size();
+        ++validCount_;
+        batches_.push_back(std::move(batch));
+    }
+
+    destroyCount_ = registry.DestroyCount();
+    return batches_.size();
+}
+
+void StaticBatcher::Clear() {
+    batches_.clear();
+    batchOf_.clear();
+    batchedCount_ = 0;
+    validCount_ = 0;
+}
+
+int StaticBatcher::BatchOf(EntityId id) const {
+    if (id.index >= batchOf_.size() || batchOf_[id.index].id != id) {
+        return -1;
+    }
+    return batchOf_[id.index].batch;
+}
+
+void StaticBatcher::Drop(std::size_t batch) {
+    StaticBatch& b = batches_[batch];
+    if (!b.valid) {
+        return;
+    }
+    b.valid = false;
+    released_.push_back(std::move(b.mesh));
+    for (EntityId member : b.members) {
+        batchOf_[member.index] = Membership{};
+    }
+    batchedCount_ -= b.members.size();
+    --validCount_;
+}
+
+void StaticBatcher::Invalidate(EntityId id) {
+    const int batch = BatchOf(id);
+    if (batch >= 0) {
+        Drop(static_cast<std::size_t>(batch));
+    }
+}
+
+void StaticBatcher::Validate(const Scene& scene) {
+    const Registry& registry = scene.registry;
+    if (registry.DestroyCount() == destroyCount_) {
+        return;
+    }
+    destroyCount_ = registry.DestroyCount();
+
+    for (std::size_t batch = 0; batch < batches_.size(); ++batch) {
+        if (!batches_[batch].valid) {
+            continue;
+        }
+        for (EntityId member : batches_[batch].members) {
+            if (!registry.IsAlive(member)) {
+                Drop(batch);
+                break;
+            }
+        }
+    }
+}
+
+void StaticBatcher::TakeReleased(std::vector<std::shared_ptr<const Mesh>>& released) {
+    for (std::shared_ptr<const Mesh>& mesh : released_) {
+        released.push_back(std::move(mesh));
+    }
+    released_.clear();
+}
+
+bool StaticBatcher::IsBatched(EntityId id) const {
+    return BatchOf(id) >= 0;
+}
+
+} // namespace ow
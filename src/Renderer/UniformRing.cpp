@@ -0,0 +1,110 @@
+#include "Engine/Renderer/UniformRing.hpp"
+
+#include "Engine/Renderer/GL.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ow {
+
+namespace {
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void WaitAndDelete(void*& fence) {
+    if (!fence) {
+        return;
+    }
+    GLsync sync = static_cast<GLsync>(fence);
+    // Normally signalled long ago; only blocks when the CPU runs kSegments frames ahead.
+    glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    glDeleteSync(sync);
+    fence = nullptr;
+}
+
+} // namespace
+
+UniformRing::~UniformRing() {
+    for (void*& fence : fences_) {
+        if (fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);
+    }
+}
+
+void UniformStaging::Begin(std::size_t alignment) {
+    alignment_ = alignment;
+    data_.clear();
+}
+
+std::size_t UniformStaging::Push(const void* data, std::size_t size) {
+    const std::size_t offset = AlignUp(data_.size(), alignment_);
+    data_.resize(offset + size);
+    std::memcpy(data_.data() + offset, data, size);
+    return offset;
+}
+
+void UniformRing::Reserve(std::size_t segmentSize) {
+    // Start at 64 KiB and double, keeping every segment start aligned for glBindBufferRange.
+    std::size_t size = std::max<std::size_t>(segmentSize_, 64 * 1024);
+    while (size < segmentSize) {
+        size *= 2;
+    }
+    segmentSize_ = AlignUp(size, Alignment());
+
+    // Reallocating orphans the old storage, so pending fences no longer guard anything.
+    for (void*& fence : fences_) {
+        if (fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(segmentSize_ * kSegments), nullptr, GL_STREAM_DRAW);
+}
+
+void UniformRing::Upload(const UniformStaging& staging) {
+    if (buffer_ == 0) {
+        glGenBuffers(1, &buffer_);
+        // Frames already staged use the 256 default; later frames pack tighter.
+        int alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment_.store(static_cast<std::size_t>(std::max(alignment, 16)), std::memory_order_relaxed);
+    }
+
+    segment_ = (segment_ + 1) % kSegments;
+    WaitAndDelete(fences_[segment_]);
+
+    if (staging.Size() == 0) {
+        return;
+    }
+    if (staging.Size() > segmentSize_) {
+        Reserve(staging.Size());
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(static_cast<std::size_t>(segment_) * segmentSize_),
+                    static_cast<GLsizeiptr>(staging.Size()), staging.Data());
+}
+
+void UniformRing::Bind(unsigned int binding, std::size_t offset, std::size_t size) const {
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer_,
+                      static_cast<GLintptr>(static_cast<std::size_t>(segment_) * segmentSize_ + offset),
+                      static_cast<GLsizeiptr>(size));
+}
+
+void UniformRing::EndFrame() {
+    if (buffer_ == 0) {
+        return;
+    }
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+} // namespace ow
@@ -0,0 +1,100 @@
+#include "Engine/Renderer/VertexFormat.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ow {
+
+namespace {
+
+std::int16_t ToSnorm16(float value) {
+    const float clamped = std::clamp(value, -1.0f, 1.0f);
+    return static_cast<std::int16_t>(std::lround(clamped * 32767.0f));
+}
+
+std::uint32_t ToSnorm10(float value) {
+    const float clamped = std::clamp(value, -1.0f, 1.0f);
+    const long v = std::lround(clamped * 511.0f);
+    return static_cast<std::uint32_t>(v) & 0x3FFu;
+}
+
+} // namespace
+
+std::size_t VertexStride(VertexFormat format) {
+    return format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+// Round-to-nearest-even conversion; overflow becomes infinity and tiny values denormals.
+std::uint16_t FloatToHalf(float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t exponent = (bits >> 23) & 0xFFu;
+    std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {
+        // Inf stays inf; NaN keeps a quiet mantissa bit.
+        return static_cast<std::uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1F) {
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+            return static_cast<std::uint16_t>(sign);
+        }
+        // Denormal: shift the mantissa (with its implicit 1) into place and round.
+        mantissa |= 0x800000u;
+        const int shift = 14 - halfExponent;
+        std::uint32_t half = mantissa >> shift;
+        const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    std::uint32_t half = (static_cast<std::uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const std::uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        // May carry into the exponent, which correctly rounds up to the next power of two.
+        ++half;
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+std::uint32_t PackNormal1010102(const Vec3& normal) {
+    return ToSnorm10(normal.x) | (ToSnorm10(normal.y) << 10) | (ToSnorm10(normal.z) << 20);
+}
+
+std::vector<PackedVertex> PackVertices(const std::vector<Vertex>& vertices, const Aabb& bounds) {
+    const Vec3 center = bounds.Center();
+    const Vec3 extents = bounds.Extents();
+    // Flat axes (zero extent) encode as 0 and decode back to the center.
+    const Vec3 inverse{
+        extents.x > 0.0f ? 1.0f / extents.x : 0.0f,
+        extents.y > 0.0f ? 1.0f / extents.y : 0.0f,
+        extents.z > 0.0f ? 1.0f / extents.z : 0.0f,
+    };
+
+    std::vector<PackedVertex> packed(vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& v = vertices[i];
+        PackedVertex& p = packed[i];
+        p.position[0] = ToSnorm16((v.position.x - center.x) * inverse.x);
+        p.position[1] = ToSnorm16((v.position.y - center.y) * inverse.y);
+        p.position[2] = ToSnorm16((v.position.z - center.z) * inverse.z);
+        p.position[3] = 0;
+        p.normal = PackNormal1010102(v.normal);
+        p.uv[0] = FloatToHalf(v.uv.x);
+        p.uv[1] = FloatToHalf(v.uv.y);
+    }
+    return packed;
+}
+
+} // namespace ow
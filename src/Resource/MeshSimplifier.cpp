@@ -0,0 +1,373 @@
+#include "Engine/Resource/MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "Engine/Renderer/Mesh.hpp"
+
+namespace ow {
+
+namespace {
+
+// Symmetric 4x4 quadric: summed squared distance to a set of area-weighted planes.
+// Dividing by the total weight turns it into a mean squared distance, so collapse costs
+// are comparable between vertices. It only orders collapses; the reported error is the
+// largest plane distance.
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double weight = 0;
+
+    void AddPlane(const Vec3& n, float d, double weight) {
+        a00 += weight * n.x * n.x;
+        a01 += weight * n.x * n.y;
+        a02 += weight * n.x * n.z;
+        a11 += weight * n.y * n.y;
+        a12 += weight * n.y * n.z;
+        a22 += weight * n.z * n.z;
+        b0 += weight * n.x * d;
+        b1 += weight * n.y * d;
+        b2 += weight * n.z * d;
+        c += weight * static_cast<double>(d) * d;
+        this->weight += weight;
+    }
+
+    void Add(const Quadric& q) {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a11 += q.a11;
+        a12 += q.a12;
+        a22 += q.a22;
+        b0 += q.b0;
+        b1 += q.b1;
+        b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+    }
+
+    double Evaluate(const Vec3& p) const {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        const double sum = x * x * a00 + 2.0 * x * y * a01 + 2.0 * x * z * a02 + y * y * a11 + 2.0 * y * z * a12 +
+                           z * z * a22 + 2.0 * (x * b0 + y * b1 + z * b2) + c;
+        return weight > 0.0 ? std::max(sum, 0.0) / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    unsigned int from = 0;
+    unsigned int to = 0;
+    double cost = 0.0;
+};
+
+std::uint64_t EdgeKey(unsigned int a, unsigned int b) {
+    return a < b ? (static_cast<std::uint64_t>(a) << 32) | b : (static_cast<std::uint64_t>(b) << 32) | a;
+}
+
+// Maps every vertex to the lowest-numbered vertex at exactly the same position.
+std::vector<unsigned int> WeldByPosition(const std::vector<Vertex>& vertices) {
+    std::vector<unsigned int> order(vertices.size());
+    for (std::size_t v = 0; v < order.size(); ++v) {
+        order[v] = static_cast<unsigned int>(v);
+    }
+    auto less = [&](unsigned int l, unsigned int r) {
+        const Vec3& a = vertices[l].position;
+        const Vec3& b = vertices[r].position;
+        if (a.x != b.x) {
+            return a.x < b.x;
+        }
+        if (a.y != b.y) {
+            return a.y < b.y;
+        }
+        if (a.z != b.z) {
+            return a.z < b.z;
+        }
+        return l < r;
+    };
+    std::sort(order.begin(), order.end(), less);
+
+    std::vector<unsigned int> group(vertices.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const bool same = i > 0 && vertices[order[i]].position.x == vertices[order[i - 1]].position.x &&
+                          vertices[order[i]].position.y == vertices[order[i - 1]].position.y &&
+                          vertices[order[i]].position.z == vertices[order[i - 1]].position.z;
+        group[order[i]] = same ? group[order[i - 1]] : order[i];
+    }
+    return group;
+}
+
+// Rejects a collapse that would turn any surviving triangle around from over. Positions
+// are read through group, so vertices already collapsed elsewhere are where they ended up.
+bool FlipsTriangle(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& group,
+                   const std::vector<unsigned int>& indices, const std::vector<unsigned int>& triangles,
+                   unsigned int from, unsigned int to) {
+    const Vec3& target = vertices[to].position;
+    for (const unsigned int t : triangles) {
+        const unsigned int* tri = &indices[static_cast<std::size_t>(t) * 3];
+        const unsigned int g[3] = {group[tri[0]], group[tri[1]], group[tri[2]]};
+        if (g[0] == to || g[1] == to || g[2] == to) {
+            continue; // collapses to a degenerate triangle and is dropped
+        }
+        Vec3 p[3];
+        Vec3 q[3];
+        for (int k = 0; k < 3; ++k) {
+            p[k] = vertices[g[k]].position;
+            q[k] = g[k] == from ? target : p[k];
+        }
+        const Vec3 before = Cross(p[1] - p[0], p[2] - p[0]);
+        const Vec3 after = Cross(q[1] - q[0], q[2] - q[0]);
+        if (Dot(before, after) <= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+SimplifyResult MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                        std::size_t targetIndexCount) {
+    SimplifyResult result;
+    result.vertices = vertices;
+    result.indices = indices;
+    if (indices.size() <= targetIndexCount || indices.size() % 3 != 0) {
+        return result;
+    }
+
+    // Topology, quadrics and borders live on welded positions: group[v] names the
+    // position vertex v currently sits at, and only group ids carry quadrics, planes and
+    // triangle lists. Each group keeps the planes of every original triangle it has
+    // absorbed; the farthest of them from where it ends up is the reported error.
+    const std::size_t vertexCount = vertices.size();
+    std::vector<unsigned int> group = WeldByPosition(vertices);
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<Plane>> planes(vertexCount);
+    std::unordered_map<std::uint64_t, int> edgeUse;
+    edgeUse.reserve(indices.size());
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const unsigned int w[3] = {group[indices[i]], group[indices[i + 1]], group[indices[i + 2]]};
+        const Vec3 normal = Cross(vertices[w[1]].position - vertices[w[0]].position,
+                                  vertices[w[2]].position - vertices[w[0]].position);
+        const float area = Length(normal);
+        if (area > 0.0f) {
+            const Vec3 n = normal * (1.0f / area);
+            const float d = -Dot(n, vertices[w[0]].position);
+            for (const unsigned int vertex : w) {
+                quadrics[vertex].AddPlane(n, d, area);
+                planes[vertex].push_back(Plane{n, d});
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            ++edgeUse[EdgeKey(w[k], w[(k + 1) % 3])];
+        }
+    }
+
+    // Open borders and non-manifold edges never move; attribute seams are welded above.
+    std::vector<char> locked(vertexCount, 0);
+    for (const auto& [key, uses] : edgeUse) {
+        if (uses != 2) {
+            locked[static_cast<std::size_t>(key >> 32)] = 1;
+            locked[static_cast<std::size_t>(key & 0xFFFFFFFFu)] = 1;
+        }
+    }
+
+    // Each pass collapses the cheapest edges whose endpoints no earlier collapse of the
+    // same pass touched, so costs and adjacency stay valid without a mutable heap.
+    std::vector<unsigned int>& current = result.indices;
+    std::vector<std::vector<unsigned int>> vertexTriangles(vertexCount);
+    std::vector<Collapse> collapses;
+    std::vector<char> touched(vertexCount);
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<std::pair<unsigned int, unsigned int>> partners;
+    float maxError = 0.0f;
+    while (current.size() > targetIndexCount) {
+        for (std::vector<unsigned int>& list : vertexTriangles) {
+            list.clear();
+        }
+        collapses.clear();
+        edgeUse.clear();
+        for (std::size_t t = 0; t * 3 < current.size(); ++t) {
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int a = group[current[t * 3 + static_cast<std::size_t>(k)]];
+                const unsigned int b = group[current[t * 3 + static_cast<std::size_t>((k + 1) % 3)]];
+                vertexTriangles[a].push_back(static_cast<unsigned int>(t));
+                if (a == b || !edgeUse.emplace(EdgeKey(a, b), 1).second) {
+                    continue;
+                }
+
+                Quadric q = quadrics[a];
+                q.Add(quadrics[b]);
+                if (!locked[a]) {
+                    collapses.push_back(Collapse{a, b, q.Evaluate(vertices[b].position)});
+                }
+                if (!locked[b]) {
+                    collapses.push_back(Collapse{b, a, q.Evaluate(vertices[a].position)});
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& l, const Collapse& r) { return l.cost < r.cost; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            remap[v] = static_cast<unsigned int>(v);
+        }
+        std::size_t remaining = current.size() / 3;
+        const std::size_t targetTriangles = targetIndexCount / 3;
+        std::size_t performed = 0;
+        for (const Collapse& collapse : collapses) {
+            if (remaining <= targetTriangles) {
+                break;
+            }
+            if (touched[collapse.from] || touched[collapse.to]) {
+                continue;
+            }
+            if (FlipsTriangle(vertices, group, current, vertexTriangles[collapse.from], collapse.from, collapse.to)) {
+                continue;
+            }
+
+            // A copy of from that shares a triangle with a copy of to merges into it, so
+            // the copies on both sides of a seam collapse together and the seam stays
+            // closed. A copy with two different partners would drag one side's
+            // attributes across the seam, so that collapse is skipped.
+            partners.clear();
+            bool consistent = true;
+            std::size_t removed = 0;
+            for (const unsigned int t : vertexTriangles[collapse.from]) {
+                const unsigned int* tri = &current[static_cast<std::size_t>(t) * 3];
+                int from = -1;
+                int to = -1;
+                for (int k = 0; k < 3; ++k) {
+                    if (group[tri[k]] == collapse.from) {
+                        from = k;
+                    } else if (group[tri[k]] == collapse.to) {
+                        to = k;
+                    }
+                }
+                if (to < 0) {
+                    continue;
+                }
+                ++removed;
+                const auto it = std::find_if(partners.begin(), partners.end(),
+                                             [&](const auto& p) { return p.first == tri[from]; });
+                if (it == partners.end()) {
+                    partners.emplace_back(tri[from], tri[to]);
+                } else if (it->second != tri[to]) {
+                    consistent = false;
+                    break;
+                }
+            }
+            if (!consistent) {
+                continue;
+            }
+
+            // Copies without a partner (faceted normals, UV charts that do not reach the
+            // other end) keep their attributes and just take the new position.
+            for (const unsigned int t : vertexTriangles[collapse.from]) {
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int v = current[static_cast<std::size_t>(t) * 3 + static_cast<std::size_t>(k)];
+                    if (group[v] != collapse.from) {
+                        continue;
+                    }
+                    for (const auto& [copy, partner] : partners) {
+                        if (copy == v) {
+                            remap[v] = partner;
+                        }
+                    }
+                    group[v] = collapse.to;
+                }
+            }
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            std::vector<Plane>& merged = planes[collapse.to];
+            merged.insert(merged.end(), planes[collapse.from].begin(), planes[collapse.from].end());
+            planes[collapse.from].clear();
+            const Vec3& target = vertices[collapse.to].position;
+            for (const Plane& plane : merged) {
+                maxError = std::max(maxError, std::fabs(plane.Distance(target)));
+            }
+
+            // Neighbours of both ends see changed triangles; leave them to the next pass.
+            for (const unsigned int end : {collapse.from, collapse.to}) {
+                for (const unsigned int t : vertexTriangles[end]) {
+                    for (int k = 0; k < 3; ++k) {
+                        touched[group[current[static_cast<std::size_t>(t) * 3 + static_cast<std::size_t>(k)]]] = 1;
+                    }
+                }
+            }
+            touched[collapse.from] = 1;
+            remaining = remaining > removed ? remaining - removed : 0;
+            ++performed;
+        }
+        if (performed == 0) {
+            break;
+        }
+
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < current.size(); i += 3) {
+            const unsigned int a = remap[current[i]];
+            const unsigned int b = remap[current[i + 1]];
+            const unsigned int c = remap[current[i + 2]];
+            if (group[a] == group[b] || group[b] == group[c] || group[a] == group[c]) {
+                continue;
+            }
+            current[out++] = a;
+            current[out++] = b;
+            current[out++] = c;
+        }
+        current.resize(out);
+    }
+
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        result.vertices[v].position = vertices[group[v]].position;
+    }
+    result.error = maxError;
+    return result;
+}
+
+std::size_t MeshSimplifier::BuildLods(Mesh& mesh, std::size_t maxLevels, std::size_t minTriangles) {
+    const std::vector<Vertex>& vertices = mesh.Vertices();
+    const std::vector<unsigned int>& indices = mesh.Indices();
+
+    std::vector<MeshLod> lods;
+    std::size_t previous = indices.size();
+    for (std::size_t level = 1; level <= maxLevels; ++level) {
+        const std::size_t target = (indices.size() / 3 >> level) * 3;
+        if (target / 3 < minTriangles) {
+            break;
+        }
+        SimplifyResult simplified = Simplify(vertices, indices, target);
+        if (simplified.indices.empty() || simplified.indices.size() * 10 > previous * 9) {
+            break;
+        }
+        previous = simplified.indices.size();
+
+        // Each level keeps only the vertices it references.
+        std::vector<Vertex> lodVertices;
+        std::unordered_map<unsigned int, unsigned int> lodIndex;
+        for (unsigned int& index : simplified.indices) {
+            const auto [it, inserted] = lodIndex.emplace(index, static_cast<unsigned int>(lodVertices.size()));
+            if (inserted) {
+                lodVertices.push_back(simplified.vertices[index]);
+            }
+            index = it->second;
+        }
+
+        MeshLod lod;
+        lod.mesh = std::make_shared<Mesh>(lodVertices, simplified.indices, mesh.Format());
+        lod.error = simplified.error;
+        lods.push_back(std::move(lod));
+    }
+
+    const std::size_t built = lods.size();
+    mesh.SetLods(std::move(lods));
+    return built;
+}
+
+} // namespace ow
@@ -8,6 +8,7 @@
 
 #include "Engine/Core/Math.hpp"
 #include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Resource/MeshSimplifier.hpp"
 
 namespace ow {
 
@@ -133,7 +134,9 @@ std::shared_ptr<Mesh> OBJLoader::Load(const std::string& path) {
         return nullptr;
     }
 
-    return std::make_shared<Mesh>(vertices, indices);
+    auto mesh = std::make_shared<Mesh>(vertices, indices);
+    MeshSimplifier::BuildLods(*mesh);
+    return mesh;
 }
 
 } // namespace ow
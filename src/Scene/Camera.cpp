@@ -28,6 +28,10 @@ Mat4 Camera::ProjectionMatrix(float aspect) const {
     return Mat4::Perspective(Radians(fov), aspect, 0.1f, 100.0f);
 }
 
+Frustum Camera::ViewFrustum(float aspect) const {
+    return Frustum::FromMatrix(ProjectionMatrix(aspect) * ViewMatrix());
+}
+
 void Camera::ProcessMouse(float deltaX, float deltaY, float sensitivity) {
     yaw += deltaX * sensitivity;
     pitch += deltaY * sensitivity;
@@ -0,0 +1,241 @@
+#include "Engine/Scene/DynamicBvh.hpp"
+
+namespace ow {
+
+namespace {
+
+float SurfaceArea(const Aabb& box) {
+    const Vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+} // namespace
+
+int DynamicBvh::AllocateNode() {
+    if (freeList_ == kNull) {
+        nodes_.emplace_back();
+        return static_cast<int>(nodes_.size() - 1);
+    }
+
+    // Free nodes chain through their parent field.
+    const int node = freeList_;
+    Node& n = nodes_[static_cast<std::size_t>(node)];
+    freeList_ = n.parent;
+    n = Node{};
+    return node;
+}
+
+void DynamicBvh::FreeNode(int node) {
+    Node& n = nodes_[static_cast<std::size_t>(node)];
+    n.parent = freeList_;
+    n.child1 = kNull;
+    n.child2 = kNull;
+    n.height = -1;
+    freeList_ = node;
+}
+
+int DynamicBvh::Insert(const Aabb& box, EntityId id) {
+    const int proxy = AllocateNode();
+    Node& node = nodes_[static_cast<std::size_t>(proxy)];
+    const Vec3 margin{margin_, margin_, margin_};
+    node.box = Aabb{box.min - margin, box.max + margin};
+    node.id = id;
+    node.height = 0;
+
+    InsertLeaf(proxy);
+    ++leafCount_;
+    return proxy;
+}
+
+void DynamicBvh::Remove(int proxy) {
+    if (proxy < 0 || static_cast<std::size_t>(proxy) >= nodes_.size() ||
+        !nodes_[static_cast<std::size_t>(proxy)].IsLeaf() || nodes_[static_cast<std::size_t>(proxy)].height < 0) {
+        return;
+    }
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --leafCount_;
+}
+
+bool DynamicBvh::Move(int proxy, const Aabb& box, const Vec3& displacement) {
+    Node& node = nodes_[static_cast<std::size_t>(proxy)];
+    if (node.box.Contains(box)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+
+    const Vec3 margin{margin_, margin_, margin_};
+    Aabb fat{box.min - margin, box.max + margin};
+    // Predict ahead along the displacement so steady movement reinserts less often.
+    const Vec3 d = displacement * 2.0f;
+    (d.x < 0.0f ? fat.min.x : fat.max.x) += d.x;
+    (d.y < 0.0f ? fat.min.y : fat.max.y) += d.y;
+    (d.z < 0.0f ? fat.min.z : fat.max.z) += d.z;
+
+    nodes_[static_cast<std::size_t>(proxy)].box = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicBvh::InsertLeaf(int leaf) {
+    if (root_ == kNull) {
+        root_ = leaf;
+        nodes_[static_cast<std::size_t>(root_)].parent = kNull;
+        return;
+    }
+
+    // Descend towards the cheapest sibling using the surface area heuristic.
+    const Aabb leafBox = nodes_[static_cast<std::size_t>(leaf)].box;
+    int index = root_;
+    while (!nodes_[static_cast<std::size_t>(index)].IsLeaf()) {
+        const Node& node = nodes_[static_cast<std::size_t>(index)];
+        const float area = SurfaceArea(node.box);
+        const float combinedArea = SurfaceArea(Merge(node.box, leafBox));
+
+        // Cost of pairing the leaf with this node, and the cost pushed down to children.
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child) {
+            const Node& c = nodes_[static_cast<std::size_t>(child)];
+            const float merged = SurfaceArea(Merge(leafBox, c.box));
+            return (c.IsLeaf() ? merged : merged - SurfaceArea(c.box)) + inheritanceCost;
+        };
+        const float cost1 = childCost(node.child1);
+        const float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int sibling = index;
+    const int oldParent = nodes_[static_cast<std::size_t>(sibling)].parent;
+    const int newParent = AllocateNode();
+    {
+        Node& parent = nodes_[static_cast<std::size_t>(newParent)];
+        const Node& s = nodes_[static_cast<std::size_t>(sibling)];
+        parent.parent = oldParent;
+        parent.box = Merge(leafBox, s.box);
+        parent.height = s.height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+    }
+
+    if (oldParent != kNull) {
+        Node& old = nodes_[static_cast<std::size_t>(oldParent)];
+        (old.child1 == sibling ? old.child1 : old.child2) = newParent;
+    } else {
+        root_ = newParent;
+    }
+    nodes_[static_cast<std::size_t>(sibling)].parent = newParent;
+    nodes_[static_cast<std::size_t>(leaf)].parent = newParent;
+
+    // Refit and rebalance the ancestors.
+    for (index = newParent; index != kNull; index = nodes_[static_cast<std::size_t>(index)].parent) {
+        index = Balance(index);
+        Node& node = nodes_[static_cast<std::size_t>(index)];
+        const Node& c1 = nodes_[static_cast<std::size_t>(node.child1)];
+        const Node& c2 = nodes_[static_cast<std::size_t>(node.child2)];
+        node.height = 1 + std::max(c1.height, c2.height);
+        node.box = Merge(c1.box, c2.box);
+    }
+}
+
+void DynamicBvh::RemoveLeaf(int leaf) {
+    if (leaf == root_) {
+        root_ = kNull;
+        return;
+    }
+
+    const int parent = nodes_[static_cast<std::size_t>(leaf)].parent;
+    const Node& p = nodes_[static_cast<std::size_t>(parent)];
+    const int grandParent = p.parent;
+    const int sibling = p.child1 == leaf ? p.child2 : p.child1;
+
+    if (grandParent == kNull) {
+        root_ = sibling;
+        nodes_[static_cast<std::size_t>(sibling)].parent = kNull;
+        FreeNode(parent);
+        return;
+    }
+
+    // Splice the sibling into the grandparent, then refit upwards.
+    Node& g = nodes_[static_cast<std::size_t>(grandParent)];
+    (g.child1 == parent ? g.child1 : g.child2) = sibling;
+    nodes_[static_cast<std::size_t>(sibling)].parent = grandParent;
+    FreeNode(parent);
+
+    for (int index = grandParent; index != kNull; index = nodes_[static_cast<std::size_t>(index)].parent) {
+        index = Balance(index);
+        Node& node = nodes_[static_cast<std::size_t>(index)];
+        const Node& c1 = nodes_[static_cast<std::size_t>(node.child1)];
+        const Node& c2 = nodes_[static_cast<std::size_t>(node.child2)];
+        node.height = 1 + std::max(c1.height, c2.height);
+        node.box = Merge(c1.box, c2.box);
+    }
+}
+
+// Rotates a grandchild up when the subtree heights under index differ by more than one.
+// Returns the index of the node now at the top of the subtree.
+int DynamicBvh::Balance(int iA) {
+    Node& a = nodes_[static_cast<std::size_t>(iA)];
+    if (a.IsLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    const int iB = a.child1;
+    const int iC = a.child2;
+    Node& b = nodes_[static_cast<std::size_t>(iB)];
+    Node& c = nodes_[static_cast<std::size_t>(iC)];
+    const int balance = c.height - b.height;
+
+    // Promotes child `up` above a; the shorter of up's two children moves down under a.
+    auto rotate = [&](int iUp, Node& up, Node& other, bool upIsChild2) {
+        const int iF = up.child1;
+        const int iG = up.child2;
+        Node& f = nodes_[static_cast<std::size_t>(iF)];
+        Node& g = nodes_[static_cast<std::size_t>(iG)];
+
+        up.child1 = iA;
+        up.parent = a.parent;
+        a.parent = iUp;
+
+        if (up.parent != kNull) {
+            Node& top = nodes_[static_cast<std::size_t>(up.parent)];
+            (top.child1 == iA ? top.child1 : top.child2) = iUp;
+        } else {
+            root_ = iUp;
+        }
+
+        const bool keepF = f.height > g.height;
+        const int iKeep = keepF ? iF : iG;
+        const int iMove = keepF ? iG : iF;
+        Node& keep = keepF ? f : g;
+        Node& move = keepF ? g : f;
+
+        up.child2 = iKeep;
+        (upIsChild2 ? a.child2 : a.child1) = iMove;
+        move.parent = iA;
+
+        a.box = Merge(other.box, move.box);
+        up.box = Merge(a.box, keep.box);
+        a.height = 1 + std::max(other.height, move.height);
+        up.height = 1 + std::max(a.height, keep.height);
+    };
+
+    if (balance > 1) {
+        rotate(iC, c, b, true);
+        return iC;
+    }
+    if (balance < -1) {
+        rotate(iB, b, c, false);
+        return iB;
+    }
+    return iA;
+}
+
+} // namespace ow
@@ -1,9 +1,91 @@
 #include "Engine/Scene/Entity.hpp"
 
+#include <cassert>
 #include <utility>
 
+#include "Engine/Scene/Scene.hpp"
+
 namespace ow {
 
-Entity::Entity(std::string entityName) : name(std::move(entityName)) {}
+bool Entity::IsValid() const {
+    return scene_ && scene_->registry.IsAlive(id_);
+}
+
+const std::string& Entity::Name() const {
+    assert(IsValid() && "Entity::Name on a destroyed entity");
+    if (!IsValid()) {
+        static const std::string empty;
+        return empty;
+    }
+    return scene_->registry.names.Get(id_);
+}
+
+Transform& Entity::GetTransform() const {
+    assert(IsValid() && "Entity::GetTransform on a destroyed entity");
+    if (!IsValid()) {
+        // Reset on every use so one stale handle's writes never show up through another.
+        static Transform scratch;
+        scratch = Transform{};
+        return scratch;
+    }
+    return scene_->registry.transforms.Get(id_);
+}
+
+Rigidbody* Entity::GetRigidbody() const {
+    return IsValid() ? scene_->registry.rigidbodies.TryGet(id_) : nullptr;
+}
+
+Rigidbody* Entity::AddRigidbody(const Rigidbody& rigidbody) const {
+    if (!IsValid()) {
+        return nullptr;
+    }
+    return &scene_->registry.rigidbodies.Add(id_, rigidbody);
+}
+
+Collider* Entity::GetCollider() const {
+    return IsValid() ? scene_->registry.colliders.TryGet(id_) : nullptr;
+}
+
+Collider* Entity::AddCollider(float radius) const {
+    if (!IsValid()) {
+        return nullptr;
+    }
+    scene_->MarkBoundsDirty(id_);
+    return &scene_->registry.colliders.Add(id_, Collider{radius});
+}
+
+Renderable* Entity::GetRenderable() const {
+    return IsValid() ? scene_->registry.renderables.TryGet(id_) : nullptr;
+}
+
+Renderable* Entity::SetRenderable(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) const {
+    if (!IsValid()) {
+        return nullptr;
+    }
+    scene_->MarkBoundsDirty(id_);
+    return &scene_->registry.renderables.Add(id_, Renderable{std::move(mesh), std::move(material)});
+}
+
+const Mat4& Entity::WorldMatrix() const {
+    assert(IsValid() && "Entity::WorldMatrix on a destroyed entity");
+    if (!IsValid()) {
+        static const Mat4 identity = Mat4::Identity();
+        return identity;
+    }
+    return scene_->hierarchy.WorldMatrix(id_);
+}
+
+Vec3 Entity::WorldPosition() const {
+    const Mat4& world = WorldMatrix();
+    return Vec3{world[12], world[13], world[14]};
+}
+
+Entity Entity::Parent() const {
+    if (!IsValid()) {
+        return Entity();
+    }
+    const EntityId parent = scene_->hierarchy.Parent(id_);
+    return parent.IsValid() ? Entity(scene_, parent) : Entity();
+}
 
 } // namespace ow
@@ -1,12 +1,99 @@
 #include "Engine/Scene/Scene.hpp"
 
-#include "Engine/Scene/Entity.hpp"
+#include "Engine/Renderer/Mesh.hpp"
 
 namespace ow {
 
-std::shared_ptr<Entity> Scene::AddEntity(const std::shared_ptr<Entity>& entity) {
-    entities.push_back(entity);
-    return entity;
+Entity Scene::CreateEntity(const std::string& name) {
+    const EntityId id = registry.Create();
+    registry.names.Add(id, name);
+    registry.transforms.Add(id);
+    hierarchy.Add(id);
+    return Entity(this, id);
+}
+
+void Scene::DestroyEntity(Entity entity) {
+    if (entity.GetScene() != this || !registry.IsAlive(entity.Id())) {
+        return;
+    }
+    RemoveProxy(entity.Id());
+    hierarchy.Remove(entity.Id());
+    registry.Destroy(entity.Id());
+}
+
+bool Scene::SetParent(Entity child, Entity parent) {
+    if (child.GetScene() != this || (parent.IsValid() && parent.GetScene() != this)) {
+        return false;
+    }
+    return hierarchy.SetParent(child.Id(), parent.IsValid() ? parent.Id() : EntityId{});
+}
+
+std::size_t Scene::UpdateTransforms() {
+    const std::size_t updated = hierarchy.Update();
+
+    for (EntityId id : hierarchy.Updated()) {
+        RefreshBounds(id);
+    }
+    for (EntityId id : boundsDirty_) {
+        if (registry.IsAlive(id)) {
+            RefreshBounds(id);
+        }
+    }
+    boundsDirty_.clear();
+    return updated;
+}
+
+bool Scene::WorldBounds(EntityId id, Aabb& out) const {
+    bool found = false;
+
+    const Renderable* renderable = registry.renderables.TryGet(id);
+    if (renderable && renderable->mesh) {
+        out = TransformAabb(renderable->mesh->LocalBounds(), hierarchy.WorldMatrix(id));
+        found = true;
+    }
+
+    const Collider* collider = registry.colliders.TryGet(id);
+    if (collider && collider->radius > 0.0f) {
+        const Mat4& world = hierarchy.WorldMatrix(id);
+        const Vec3 center{world[12], world[13], world[14]};
+        const Vec3 r{collider->radius, collider->radius, collider->radius};
+        const Aabb sphereBox{center - r, center + r};
+        out = found ? Merge(out, sphereBox) : sphereBox;
+        found = true;
+    }
+    return found;
+}
+
+void Scene::RefreshBounds(EntityId id) {
+    Aabb box;
+    if (!WorldBounds(id, box)) {
+        RemoveProxy(id);
+        return;
+    }
+
+    if (id.index >= proxyOf_.size()) {
+        proxyOf_.resize(static_cast<std::size_t>(id.index) + 1, DynamicBvh::kNull);
+    }
+
+    int& proxy = proxyOf_[id.index];
+    if (proxy == DynamicBvh::kNull) {
+        proxy = spatial.Insert(box, id);
+        return;
+    }
+
+    // Look ahead roughly two frames of travel so moving bodies reinsert less often.
+    const float kLookahead = 1.0f / 30.0f;
+    const Rigidbody* rigidbody = registry.rigidbodies.TryGet(id);
+    const Vec3 displacement = rigidbody ? rigidbody->velocity * kLookahead : Vec3{0.0f, 0.0f, 0.0f};
+    spatial.Move(proxy, box, displacement);
+}
+
+void Scene::RemoveProxy(EntityId id) {
+    if (id.index >= proxyOf_.size() || proxyOf_[id.index] == DynamicBvh::kNull) {
+        return;
+    }
+    spatial.Remove(proxyOf_[id.index]);
+    proxyOf_[id.index] = DynamicBvh::kNull;
 }
 
 } // namespace ow
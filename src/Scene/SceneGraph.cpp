@@ -0,0 +1,177 @@
+#include "Engine/Scene/SceneGraph.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace ow {
+
+bool SceneGraph::Contains(EntityId id) const {
+    if (id.index >= nodeOf_.size() || nodeOf_[id.index] < 0) {
+        return false;
+    }
+    return ids_[static_cast<std::size_t>(nodeOf_[id.index])] == id;
+}
+
+void SceneGraph::Add(EntityId id) {
+    if (Contains(id) || !registry_.transforms.Has(id)) {
+        return;
+    }
+
+    if (id.index >= nodeOf_.size()) {
+        nodeOf_.resize(static_cast<std::size_t>(id.index) + 1, -1);
+    }
+
+    const Transform& local = registry_.transforms.Get(id);
+    nodeOf_[id.index] = static_cast<int>(ids_.size());
+    ids_.push_back(id);
+    parents_.push_back(-1);
+    localVersions_.push_back(local.Version());
+    changed_.push_back(1);
+    world_.push_back(local.Matrix());
+}
+
+void SceneGraph::Remove(EntityId id) {
+    const int node = NodeOf(id);
+    if (node < 0) {
+        return;
+    }
+
+    const std::size_t last = ids_.size() - 1;
+
+    // Orphan direct children; they keep their local transform as the new world transform.
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+        if (parents_[i] == node) {
+            parents_[i] = -1;
+            changed_[i] = 1;
+        }
+    }
+
+    // Swap-remove, then fix up any parent links that pointed at the moved node.
+    const std::size_t index = static_cast<std::size_t>(node);
+    if (index != last) {
+        ids_[index] = ids_[last];
+        parents_[index] = parents_[last];
+        localVersions_[index] = localVersions_[last];
+        changed_[index] = changed_[last];
+        world_[index] = world_[last];
+        nodeOf_[ids_[index].index] = node;
+        for (int& parent : parents_) {
+            if (parent == static_cast<int>(last)) {
+                parent = node;
+            }
+        }
+        orderDirty_ = true;
+    }
+
+    ids_.pop_back();
+    parents_.pop_back();
+    localVersions_.pop_back();
+    changed_.pop_back();
+    world_.pop_back();
+    nodeOf_[id.index] = -1;
+}
+
+bool SceneGraph::SetParent(EntityId child, EntityId parent) {
+    const int childNode = NodeOf(child);
+    const int parentNode = parent.IsValid() ? NodeOf(parent) : -1;
+    if (childNode < 0 || (parent.IsValid() && parentNode < 0) || parentNode == childNode) {
+        return false;
+    }
+
+    for (int ancestor = parentNode; ancestor >= 0; ancestor = parents_[static_cast<std::size_t>(ancestor)]) {
+        if (ancestor == childNode) {
+            return false;
+        }
+    }
+
+    const std::size_t index = static_cast<std::size_t>(childNode);
+    parents_[index] = parentNode;
+    changed_[index] = 1;
+
+    if (parentNode > childNode) {
+        orderDirty_ = true;
+    }
+    return true;
+}
+
+EntityId SceneGraph::Parent(EntityId id) const {
+    const int node = NodeOf(id);
+    if (node < 0) {
+        return EntityId{};
+    }
+    const int parent = parents_[static_cast<std::size_t>(node)];
+    return parent >= 0 ? ids_[static_cast<std::size_t>(parent)] : EntityId{};
+}
+
+void SceneGraph::RebuildOrder() {
+    const std::size_t count = ids_.size();
+
+    std::vector<int> depth(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int p = parents_[i]; p >= 0; p = parents_[static_cast<std::size_t>(p)]) {
+            ++depth[i];
+        }
+    }
+
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return depth[static_cast<std::size_t>(a)] < depth[static_cast<std::size_t>(b)];
+    });
+
+    std::vector<int> remap(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        remap[static_cast<std::size_t>(order[i])] = static_cast<int>(i);
+    }
+
+    std::vector<EntityId> ids(count);
+    std::vector<int> parents(count);
+    std::vector<std::uint32_t> versions(count);
+    std::vector<std::uint8_t> changed(count);
+    std::vector<Mat4> world(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t src = static_cast<std::size_t>(order[i]);
+        ids[i] = ids_[src];
+        parents[i] = parents_[src] >= 0 ? remap[static_cast<std::size_t>(parents_[src])] : -1;
+        versions[i] = localVersions_[src];
+        changed[i] = changed_[src];
+        world[i] = world_[src];
+        nodeOf_[ids[i].index] = static_cast<int>(i);
+    }
+
+    ids_.swap(ids);
+    parents_.swap(parents);
+    localVersions_.swap(versions);
+    changed_.swap(changed);
+    world_.swap(world);
+    orderDirty_ = false;
+}
+
+std::size_t SceneGraph::Update() {
+    if (orderDirty_) {
+        RebuildOrder();
+    }
+
+    updated_.clear();
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+        const Transform& local = registry_.transforms.Get(ids_[i]);
+        const int parent = parents_[i];
+
+        const bool localChanged = local.Version() != localVersions_[i];
+        const bool parentChanged = parent >= 0 && changed_[static_cast<std::size_t>(parent)] != 0;
+        if (!localChanged && !parentChanged && changed_[i] == 0) {
+            continue;
+        }
+
+        world_[i] = parent >= 0 ? world_[static_cast<std::size_t>(parent)] * local.Matrix() : local.Matrix();
+        localVersions_[i] = local.Version();
+        changed_[i] = 1;
+        updated_.push_back(ids_[i]);
+    }
+
+    // changed_ doubles as "recomputed this pass" for children further down the array.
+    std::fill(changed_.begin(), changed_.end(), static_cast<std::uint8_t>(0));
+    return updated_.size();
+}
+
+} // namespace ow
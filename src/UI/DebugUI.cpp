@@ -4,6 +4,7 @@
 
 #include <SDL.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
@@ -19,9 +20,11 @@ struct Glyph5x7 {
 
 constexpr Glyph5x7 kGlyphs[] = {
     {' ', {0, 0, 0, 0, 0, 0, 0}},
+    {'+', {0, 4, 4, 31, 4, 4, 0}},
     {'-', {0, 0, 0, 31, 0, 0, 0}},
     {'.', {0, 0, 0, 0, 0, 12, 12}},
     {':', {0, 12, 12, 0, 12, 12, 0}},
+    {'=', {0, 0, 31, 0, 31, 0, 0}},
     {'|', {4, 4, 4, 4, 4, 4, 4}},
     {'0', {14, 17, 19, 21, 25, 17, 14}},
     {'1', {4, 12, 4, 4, 4, 4, 14}},
@@ -145,9 +148,10 @@ bool DebugUI::Init() {
     glBindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
 
-    vertexCapacity_ = 16384;
-    vertices_ = new float[vertexCapacity_ * 6];
-    glBufferData(GL_ARRAY_BUFFER, static_cast<long>(vertexCapacity_ * 6 * static_cast<int>(sizeof(float))), nullptr, GL_DYNAMIC_DRAW);
+    // Starting size only; Render grows the buffer when a frame's text needs more.
+    bufferCapacity_ = 16384;
+    vertices_.reserve(static_cast<size_t>(bufferCapacity_) * 6);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<long>(bufferCapacity_ * 6 * static_cast<int>(sizeof(float))), nullptr, GL_DYNAMIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 6, reinterpret_cast<void*>(0));
@@ -171,10 +175,9 @@ void DebugUI::Shutdown() {
         glDeleteProgram(shaderProgram_);
         shaderProgram_ = 0;
     }
-    delete[] vertices_;
-    vertices_ = nullptr;
-    vertexCount_ = 0;
-    vertexCapacity_ = 0;
+    vertices_.clear();
+    vertices_.shrink_to_fit();
+    bufferCapacity_ = 0;
 }
 
 void DebugUI::SetViewport(int width, int height) {
@@ -269,28 +272,39 @@ void DebugUI::HandleEvent(const SDL_Event& event, bool& settingsOpen, bool& runn
         } else {
             settings_.ps2FogStrength = 0.18f;
         }
+    } else if (key == SDL_SCANCODE_9) {
+        settings_.multiDrawIndirect = !settings_.multiDrawIndirect;
+    } else if (key == SDL_SCANCODE_0) {
+        if (settings_.depthPrePass == DepthPrePassMode::Off) {
+            settings_.depthPrePass = DepthPrePassMode::On;
+        } else if (settings_.depthPrePass == DepthPrePassMode::On) {
+            settings_.depthPrePass = DepthPrePassMode::Auto;
+        } else {
+            settings_.depthPrePass = DepthPrePassMode::Off;
+        }
+    } else if (key == SDL_SCANCODE_MINUS) {
+        if (settings_.resolutionMode == ResolutionMode::Native) {
+            settings_.resolutionMode = ResolutionMode::Scaled;
+        } else if (settings_.resolutionMode == ResolutionMode::Scaled) {
+            settings_.resolutionMode = ResolutionMode::Fixed;
+        } else if (settings_.resolutionMode == ResolutionMode::Fixed) {
+            settings_.resolutionMode = ResolutionMode::Dynamic;
+        } else {
+            settings_.resolutionMode = ResolutionMode::Native;
+        }
+    } else if (key == SDL_SCANCODE_EQUALS) {
+        settings_.lodBias = settings_.lodBias >= 2.0f ? -1.0f : settings_.lodBias + 1.0f;
     }
 }
 
 void DebugUI::AppendRect(float x, float y, float w, float h, float r, float g, float b, float a) const {
-    if (vertexCount_ + 6 >= vertexCapacity_) {
-        return;
-    }
-
     const float l = (x / static_cast<float>(viewportWidth_)) * 2.0f - 1.0f;
     const float rPos = ((x + w) / static_cast<float>(viewportWidth_)) * 2.0f - 1.0f;
     const float t = 1.0f - (y / static_cast<float>(viewportHeight_)) * 2.0f;
     const float bPos = 1.0f - ((y + h) / static_cast<float>(viewportHeight_)) * 2.0f;
 
     auto push = [&](float px, float py) {
-        const int idx = vertexCount_ * 6;
-        vertices_[idx + 0] = px;
-        vertices_[idx + 1] = py;
-        vertices_[idx + 2] = r;
-        vertices_[idx + 3] = g;
-        vertices_[idx + 4] = b;
-        vertices_[idx + 5] = a;
-        ++vertexCount_;
+        vertices_.insert(vertices_.end(), {px, py, r, g, b, a});
     };
 
     push(l, t);
@@ -322,15 +336,21 @@ void DebugUI::AppendText(float x, float y, float scale, const std::string& text,
 
     for (char c : text) {
         const unsigned char* rows = Glyph(c);
+        // One rect per horizontal run of lit pixels rather than per pixel.
         for (int row = 0; row < 7; ++row) {
-            for (int col = 0; col < 5; ++col) {
-                const bool on = (rows[row] & (1 << (4 - col))) != 0;
-                if (!on) {
+            int col = 0;
+            while (col < 5) {
+                if ((rows[row] & (1 << (4 - col))) == 0) {
+                    ++col;
                     continue;
                 }
-                AppendRect(cursor + static_cast<float>(col) * pixel,
+                const int start = col;
+                while (col < 5 && (rows[row] & (1 << (4 - col))) != 0) {
+                    ++col;
+                }
+                AppendRect(cursor + static_cast<float>(start) * pixel,
                            y + static_cast<float>(row) * pixel,
-                           pixel,
+                           pixel * static_cast<float>(col - start),
                            pixel,
                            r, g, b, a);
             }
@@ -340,23 +360,58 @@ void DebugUI::AppendText(float x, float y, float scale, const std::string& text,
 }
 
 void DebugUI::Render(bool settingsOpen) const {
-    vertexCount_ = 0;
+    vertices_.clear();
 
     if (showDebug_) {
-        AppendRect(12.0f, 12.0f, 390.0f, 92.0f, 0.05f, 0.08f, 0.12f, 0.72f);
+        const float gpuHeight = 24.0f * static_cast<float>(gpuTimings_.size());
+        const float dynamicHeight = dynamicResolution_.active ? 24.0f : 0.0f;
+        AppendRect(12.0f, 12.0f, 440.0f, 164.0f + dynamicHeight + gpuHeight, 0.05f, 0.08f, 0.12f, 0.72f);
 
         char line1[64]{};
         char line2[64]{};
+        char line3[64]{};
         std::snprintf(line1, sizeof(line1), "FPS %.1f", fps_);
-        std::snprintf(line2, sizeof(line2), "FRAME %.2f MS", frameMs_);
+        std::snprintf(line2, sizeof(line2), "FRAME %.2f MS RES %dX%d", frameMs_, renderStats_.renderWidth,
+                      renderStats_.renderHeight);
+        std::snprintf(line3, sizeof(line3), "DRAWN %d CULLED %d CALLS %d", renderStats_.visible, renderStats_.culled,
+                      renderStats_.drawCalls);
         AppendText(22.0f, 24.0f, 2.0f, line1, 0.92f, 0.96f, 1.0f, 1.0f);
         AppendText(22.0f, 48.0f, 2.0f, line2, 0.78f, 0.89f, 0.98f, 1.0f);
-        AppendText(22.0f, 72.0f, 2.0f, "ESC SETTINGS | F2 ABOUT | F10 EXIT", 0.95f, 0.83f, 0.58f, 1.0f);
+        AppendText(22.0f, 72.0f, 2.0f, line3, 0.78f, 0.89f, 0.98f, 1.0f);
+        const char* submitLine = renderStats_.indirect ? "SUBMIT MDI"
+                                 : renderStats_.indirectSupported ? "SUBMIT LOOP"
+                                                                  : "SUBMIT LOOP - NO GL 4.3";
+        AppendText(22.0f, 96.0f, 2.0f, submitLine, 0.78f, 0.89f, 0.98f, 1.0f);
+        char line5[64]{};
+        std::snprintf(line5, sizeof(line5), "OVERDRAW %.2f PREPASS %s LOD %d", renderStats_.overdraw,
+                      renderStats_.depthPrePass ? "ON" : "OFF", renderStats_.lodDraws);
+        AppendText(22.0f, 120.0f, 2.0f, line5, 0.78f, 0.89f, 0.98f, 1.0f);
+        float y = 144.0f;
+        if (dynamicResolution_.active) {
+            // Headroom turns red once the frame is over budget.
+            const float headroom = dynamicResolution_.budgetMs - dynamicResolution_.costMs;
+            char dynamicLine[64]{};
+            std::snprintf(dynamicLine, sizeof(dynamicLine), "DYN SCALE %.2f HEADROOM %.2f MS", dynamicResolution_.scale,
+                          headroom);
+            if (headroom < 0.0f) {
+                AppendText(22.0f, y, 2.0f, dynamicLine, 1.0f, 0.55f, 0.45f, 1.0f);
+            } else {
+                AppendText(22.0f, y, 2.0f, dynamicLine, 0.78f, 0.89f, 0.98f, 1.0f);
+            }
+            y += 24.0f;
+        }
+        for (const GpuTiming& timing : gpuTimings_) {
+            char gpuLine[64]{};
+            std::snprintf(gpuLine, sizeof(gpuLine), "GPU %s %.2f MS", timing.name, timing.averageMs);
+            AppendText(22.0f + 16.0f * static_cast<float>(timing.depth), y, 2.0f, gpuLine, 0.70f, 0.93f, 0.78f, 1.0f);
+            y += 24.0f;
+        }
+        AppendText(22.0f, y, 2.0f, "ESC SETTINGS | F2 ABOUT | F10 EXIT", 0.95f, 0.83f, 0.58f, 1.0f);
     }
 
     if (settingsOpen) {
         const float panelW = 560.0f;
-        const float panelH = 330.0f;
+        const float panelH = 442.0f;
         const float px = (static_cast<float>(viewportWidth_) - panelW) * 0.5f;
         const float py = (static_cast<float>(viewportHeight_) - panelH) * 0.5f;
 
@@ -386,7 +441,31 @@ void DebugUI::Render(bool settingsOpen) const {
         std::snprintf(fogLine, sizeof(fogLine), "8 FOG %.2f", settings_.ps2FogStrength);
         AppendText(px + 24.0f, py + 266.0f, 2.0f, fogLine, 0.90f, 0.97f, 1.0f, 1.0f);
 
-        AppendText(px + 24.0f, py + 296.0f, 2.0f, "ESC CLOSE | F1 HIDE HUD", 0.96f, 0.84f, 0.61f, 1.0f);
+        AppendText(px + 24.0f, py + 294.0f, 2.0f, settings_.multiDrawIndirect ? "9 INDIRECT DRAW ON" : "9 INDIRECT DRAW OFF", 0.90f, 0.97f, 1.0f, 1.0f);
+
+        const char* prePassLine = settings_.depthPrePass == DepthPrePassMode::On    ? "0 DEPTH PREPASS ON"
+                                  : settings_.depthPrePass == DepthPrePassMode::Off ? "0 DEPTH PREPASS OFF"
+                                                                                    : "0 DEPTH PREPASS AUTO";
+        AppendText(px + 24.0f, py + 322.0f, 2.0f, prePassLine, 0.90f, 0.97f, 1.0f, 1.0f);
+
+        char resolutionLine[64]{};
+        if (settings_.resolutionMode == ResolutionMode::Scaled) {
+            std::snprintf(resolutionLine, sizeof(resolutionLine), "- RESOLUTION SCALE %.2f", settings_.resolutionScale);
+        } else if (settings_.resolutionMode == ResolutionMode::Fixed) {
+            std::snprintf(resolutionLine, sizeof(resolutionLine), "- RESOLUTION %dX%d", settings_.fixedWidth,
+                          settings_.fixedHeight);
+        } else if (settings_.resolutionMode == ResolutionMode::Dynamic) {
+            std::snprintf(resolutionLine, sizeof(resolutionLine), "- RESOLUTION DYNAMIC");
+        } else {
+            std::snprintf(resolutionLine, sizeof(resolutionLine), "- RESOLUTION NATIVE");
+        }
+        AppendText(px + 24.0f, py + 350.0f, 2.0f, resolutionLine, 0.90f, 0.97f, 1.0f, 1.0f);
+
+        char lodLine[64]{};
+        std::snprintf(lodLine, sizeof(lodLine), "= LOD BIAS %+.0f", settings_.lodBias);
+        AppendText(px + 24.0f, py + 378.0f, 2.0f, lodLine, 0.90f, 0.97f, 1.0f, 1.0f);
+
+        AppendText(px + 24.0f, py + 408.0f, 2.0f, "ESC CLOSE | F1 HIDE HUD", 0.96f, 0.84f, 0.61f, 1.0f);
     }
 
     if (aboutOpen_) {
@@ -407,7 +486,8 @@ void DebugUI::Render(bool settingsOpen) const {
         AppendText(px + 24.0f, py + panelH - 34.0f, 2.0f, "F2 CLOSE ABOUT", 0.96f, 0.84f, 0.61f, 1.0f);
     }
 
-    if (vertexCount_ <= 0) {
+    const int vertexCount = static_cast<int>(vertices_.size() / 6);
+    if (vertexCount <= 0) {
         return;
     }
 
@@ -420,8 +500,12 @@ void DebugUI::Render(bool settingsOpen) const {
     glUseProgram(shaderProgram_);
     glBindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<long>(vertexCount_ * 6 * static_cast<int>(sizeof(float))), vertices_);
-    glDrawArrays(GL_TRIANGLES, 0, vertexCount_);
+    if (vertexCount > bufferCapacity_) {
+        bufferCapacity_ = std::max(bufferCapacity_ * 2, vertexCount);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<long>(bufferCapacity_ * 6 * static_cast<int>(sizeof(float))), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<long>(vertexCount * 6 * static_cast<int>(sizeof(float))), vertices_.data());
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
     glBindVertexArray(0);
     glUseProgram(0);
 
@@ -3,6 +3,7 @@
 
 #include <SDL.h>
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
@@ -12,14 +13,22 @@
 
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/GameState.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/WorkerThread.hpp"
 #include "Engine/Input/Input.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Physics/PhysicsSystem.hpp"
+#include "Engine/Renderer/DynamicResolution.hpp"
 #include "Engine/Renderer/GL.hpp"
+#include "Engine/Renderer/GpuProfiler.hpp"
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/MeshArena.hpp"
+#include "Engine/Renderer/PostProcess.hpp"
+#include "Engine/Renderer/ProgramCache.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/ShaderVariants.hpp"
 #include "Engine/Resource/MaterialLoader.hpp"
 #include "Engine/Resource/OBJLoader.hpp"
 #include "Engine/Scene/Camera.hpp"
@@ -35,25 +44,39 @@ const char* kVertexShader = R"(
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aUV;
-
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform vec2 uResolution;
-uniform int uPs2Aesthetic;
-uniform float uPs2Jitter;
+// Per-instance, streamed by the renderer (see InstanceBuffer.hpp).
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat3 aNormalMatrix;
+
+// Block layouts mirror include/Engine/Renderer/UniformBlocks.hpp.
+layout(std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uLightDir;
+    float uPs2Jitter;
+    vec3 uLightColor;
+    float uPs2ColorLevels;
+    vec3 uViewPos;
+    float uPs2FogStrength;
+    vec2 uResolution;
+    int uPs2Aesthetic;
+    int uShadeSteps;
+};
 
 out vec3 vNormal;
 out vec2 vUV;
 out float vViewDepth;
 out vec3 vWorldPos;
+// The depth pre-pass variant must produce bit-identical depth for the GL_EQUAL shading pass.
+invariant gl_Position;
 
 void main() {
-    vec4 worldPos = uModel * vec4(aPos, 1.0);
+    vec4 worldPos = aModel * vec4(aPos, 1.0);
     vec4 viewPos = uView * worldPos;
     vec4 clipPos = uProjection * viewPos;
 
-    if (uPs2Aesthetic == 1 && clipPos.w > 0.0001) {
+#ifdef OW_PS2
+    if (clipPos.w > 0.0001) {
         vec2 safeResolution = max(uResolution, vec2(1.0));
         vec2 snapGrid = max(safeResolution * 0.35, vec2(64.0));
         vec2 ndc = clipPos.xy / clipPos.w;
@@ -64,8 +87,9 @@ void main() {
         ndc += jitterNdc;
         clipPos.xy = ndc * clipPos.w;
     }
+#endif
 
-    vNormal = mat3(transpose(inverse(uModel))) * aNormal;
+    vNormal = aNormalMatrix * aNormal;
     vUV = aUV;
     vViewDepth = max(-viewPos.z, 0.0);
     vWorldPos = worldPos.xyz;
@@ -80,48 +104,53 @@ in vec2 vUV;
 in float vViewDepth;
 in vec3 vWorldPos;
 
-uniform vec3 uLightDir;
-uniform vec3 uLightColor;
-uniform vec3 uColor;
-uniform vec3 uEmissiveColor;
-uniform vec3 uViewPos;
-
+layout(std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uLightDir;
+    float uPs2Jitter;
+    vec3 uLightColor;
+    float uPs2ColorLevels;
+    vec3 uViewPos;
+    float uPs2FogStrength;
+    vec2 uResolution;
+    int uPs2Aesthetic;
+    int uShadeSteps;
+};
+
+layout(std140) uniform MaterialBlock {
+    vec3 uColor;
+    float uRoughness;
+    vec3 uEmissiveColor;
+    float uEmissiveStrength;
+    int uUseAlbedoTexture;
+    int uUseEmissiveTexture;
+};
+
+#ifdef OW_ALBEDO_TEXTURE
 uniform sampler2D uTextureAlbedo;
+#endif
+#ifdef OW_EMISSIVE_TEXTURE
 uniform sampler2D uTextureEmissive;
-
-uniform int uUseAlbedoTexture;
-uniform int uUseEmissiveTexture;
-uniform int uShadeSteps;
-uniform int uPs2Aesthetic;
-uniform float uRoughness;
-uniform float uEmissiveStrength;
-uniform float uPs2Jitter;
-uniform float uPs2ColorLevels;
-uniform float uPs2FogStrength;
+#endif
 
 out vec4 FragColor;
 
+#ifdef OW_PS2
 float Hash12(vec2 p) {
     vec3 p3 = fract(vec3(p.xyx) * 0.1031);
     p3 += dot(p3, p3.yzx + 33.33);
     return fract((p3.x + p3.y) * p3.z);
 }
-
-float Bayer4x4(vec2 p) {
-    vec2 f = floor(mod(p, 4.0));
-    float idx = f.x + f.y * 4.0;
-    float table[16] = float[](
-         0.0,  8.0,  2.0, 10.0,
-        12.0,  4.0, 14.0,  6.0,
-         3.0, 11.0,  1.0,  9.0,
-        15.0,  7.0, 13.0,  5.0
-    );
-    return table[int(idx)] / 16.0;
-}
+#endif
 
 void main() {
+#ifdef OW_DEPTH_ONLY
+    FragColor = vec4(0.0);
+#else
     vec3 normal = normalize(vNormal);
-    if (uPs2Aesthetic == 1) {
+#ifdef OW_PS2
+    {
         vec3 ddx = dFdx(vWorldPos);
         vec3 ddy = dFdy(vWorldPos);
         vec3 faceNormal = normalize(cross(ddx, ddy));
@@ -129,6 +158,7 @@ void main() {
             normal = gl_FrontFacing ? faceNormal : -faceNormal;
         }
     }
+#endif
 
     float ndl = max(dot(normal, -normalize(uLightDir)), 0.0);
 
@@ -140,7 +170,8 @@ void main() {
 
     vec3 base = uColor;
     vec2 sampledUv = vUV;
-    if (uPs2Aesthetic == 1) {
+#ifdef OW_PS2
+    {
         float warp = clamp(vViewDepth * 0.02, 0.0, 1.0);
         float grid = mix(64.0, 14.0, warp);
         sampledUv = floor(sampledUv * grid + vec2(0.5)) / grid;
@@ -150,17 +181,18 @@ void main() {
         float shimmer = Hash12(fragBucket + vec2(vViewDepth, warp * 11.0));
         sampledUv += (shimmer - 0.5) * (0.0032 * uPs2Jitter);
     }
-
-    if (uUseAlbedoTexture == 1) {
-        vec3 albedo = texture(uTextureAlbedo, sampledUv).rgb;
-        if (uPs2Aesthetic == 1) {
-            float chromaShift = (0.0012 + 0.0028 * clamp(vViewDepth * 0.015, 0.0, 1.0)) * (0.6 + uPs2Jitter * 0.25);
-            vec3 albedoR = texture(uTextureAlbedo, sampledUv + vec2(chromaShift, 0.0)).rgb;
-            vec3 albedoB = texture(uTextureAlbedo, sampledUv - vec2(chromaShift, 0.0)).rgb;
-            albedo = vec3(albedoR.r, albedo.g, albedoB.b);
-        }
-        base *= albedo;
-    }
+#endif
+
+#ifdef OW_ALBEDO_TEXTURE
+    vec3 albedo = texture(uTextureAlbedo, sampledUv).rgb;
+#ifdef OW_PS2
+    float chromaShift = (0.0012 + 0.0028 * clamp(vViewDepth * 0.015, 0.0, 1.0)) * (0.6 + uPs2Jitter * 0.25);
+    vec3 albedoR = texture(uTextureAlbedo, sampledUv + vec2(chromaShift, 0.0)).rgb;
+    vec3 albedoB = texture(uTextureAlbedo, sampledUv - vec2(chromaShift, 0.0)).rgb;
+    albedo = vec3(albedoR.r, albedo.g, albedoB.b);
+#endif
+    base *= albedo;
+#endif
 
     float lightBand = ambient + diffuse;
     float steps = max(float(uShadeSteps), 1.0);
@@ -170,44 +202,96 @@ void main() {
     vec3 halfDir = normalize(viewDir - normalize(uLightDir));
     float specPower = mix(12.0, 44.0, 1.0 - clamp(roughness, 0.0, 1.0));
     float specular = pow(max(dot(normal, halfDir), 0.0), specPower);
-    if (uPs2Aesthetic == 1) {
-        specular = floor(specular * 4.0) / 4.0;
-    }
+#ifdef OW_PS2
+    specular = floor(specular * 4.0) / 4.0;
+#endif
 
     vec3 emissive = uEmissiveColor * emissiveStrength;
-    if (uUseEmissiveTexture == 1) {
-        emissive *= texture(uTextureEmissive, sampledUv).rgb;
-    }
+#ifdef OW_EMISSIVE_TEXTURE
+    emissive *= texture(uTextureEmissive, sampledUv).rgb;
+#endif
 
     vec3 lit = base * lightBand * uLightColor + emissive;
     lit += vec3(1.0, 0.96, 0.86) * specular * (0.25 + (1.0 - roughness) * 0.55);
 
-    if (uPs2Aesthetic == 1) {
-        float shadowRamp = clamp(lightBand, 0.0, 1.0);
-        vec3 shadowTint = vec3(0.76, 0.70, 0.84);
-        vec3 warmTint = vec3(1.0, 0.96, 0.88);
-        lit *= mix(shadowTint, warmTint, shadowRamp);
-
-        float levels = max(uPs2ColorLevels, 2.0);
-        float dither = (Bayer4x4(gl_FragCoord.xy) - 0.5) / levels;
-        vec2 coarsePixel = floor(gl_FragCoord.xy / 2.0);
-        float interlace = (mod(coarsePixel.y, 2.0) * 2.0 - 1.0) * 0.025;
-        lit += vec3(interlace);
-        lit = clamp(lit + dither, 0.0, 1.0);
-
-        vec3 video = pow(lit, vec3(0.4545));
-        video = floor(video * levels + 0.5) / levels;
-        lit = pow(video, vec3(2.2));
-
-        vec3 fogColor = vec3(0.43, 0.50, 0.56);
-        float fogAmount = clamp((vViewDepth - 1.0) / 30.0, 0.0, 1.0) * uPs2FogStrength;
-        lit = mix(lit, fogColor, fogAmount);
-    }
+#ifdef OW_PS2
+    float shadowRamp = clamp(lightBand, 0.0, 1.0);
+    vec3 shadowTint = vec3(0.76, 0.70, 0.84);
+    vec3 warmTint = vec3(1.0, 0.96, 0.88);
+    lit *= mix(shadowTint, warmTint, shadowRamp);
+    // Interlace, dither, colour quantization and fog run once per pixel in the post chain.
+#endif
 
     FragColor = vec4(lit, 1.0);
+#endif
+}
+)";
+
+// PS2 stylization, applied once per screen pixel by the renderer's post-process chain
+// (see PostProcess.hpp). Background pixels keep the clear colour, as before.
+const char* kInterlaceEffect = R"(
+vec3 Ps2Interlace(vec3 color, PostPixel p) {
+    if (p.background) {
+        return color;
+    }
+    vec2 coarsePixel = floor(p.coord / 2.0);
+    return color + vec3((mod(coarsePixel.y, 2.0) * 2.0 - 1.0) * 0.025);
+}
+)";
+
+const char* kDitherEffect = R"(
+float Bayer4x4(vec2 p) {
+    vec2 f = floor(mod(p, 4.0));
+    float idx = f.x + f.y * 4.0;
+    float table[16] = float[](
+         0.0,  8.0,  2.0, 10.0,
+        12.0,  4.0, 14.0,  6.0,
+         3.0, 11.0,  1.0,  9.0,
+        15.0,  7.0, 13.0,  5.0
+    );
+    return table[int(idx)] / 16.0;
+}
+
+vec3 Ps2Dither(vec3 color, PostPixel p) {
+    if (p.background) {
+        return color;
+    }
+    float levels = max(uPs2ColorLevels, 2.0);
+    return clamp(color + (Bayer4x4(p.coord) - 0.5) / levels, 0.0, 1.0);
+}
+)";
+
+const char* kQuantizeEffect = R"(
+vec3 Ps2Quantize(vec3 color, PostPixel p) {
+    if (p.background) {
+        return color;
+    }
+    float levels = max(uPs2ColorLevels, 2.0);
+    vec3 video = pow(color, vec3(0.4545));
+    video = floor(video * levels + 0.5) / levels;
+    return pow(video, vec3(2.2));
+}
+)";
+
+const char* kFogEffect = R"(
+vec3 Ps2Fog(vec3 color, PostPixel p) {
+    if (p.background) {
+        return color;
+    }
+    vec3 fogColor = vec3(0.43, 0.50, 0.56);
+    float fogAmount = clamp((p.viewDepth - 1.0) / 30.0, 0.0, 1.0) * uPs2FogStrength;
+    return mix(color, fogColor, fogAmount);
 }
 )";
 
+void AddPs2PostEffects(ow::PostProcessChain& chain) {
+    const auto ps2 = [](const ow::RenderSettings& settings) { return settings.ps2Aesthetic; };
+    chain.Add(ow::PostEffect{"interlace", "Ps2Interlace", kInterlaceEffect, ps2});
+    chain.Add(ow::PostEffect{"dither", "Ps2Dither", kDitherEffect, ps2});
+    chain.Add(ow::PostEffect{"quantize", "Ps2Quantize", kQuantizeEffect, ps2});
+    chain.Add(ow::PostEffect{"fog", "Ps2Fog", kFogEffect, ps2});
+}
+
 std::shared_ptr<ow::Material> CreateFallbackMaterial(
     const std::shared_ptr<ow::Shader>& shader,
     const ow::Vec3& color,
@@ -238,53 +322,28 @@ std::string ResolveAssetPath(const std::string& relativePath) {
     return relativePath;
 }
 
-} // namespace
-
-int main() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
-        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << '\n';
-        return EXIT_FAILURE;
-    }
-
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
-    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-
-    SDL_Window* window = SDL_CreateWindow(
-        "OpenWare - Retro RenderWare Style",
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        1280,
-        720,
-        SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
-
-    if (!window) {
-        std::cerr << "Failed to create window: " << SDL_GetError() << '\n';
-        SDL_Quit();
-        return EXIT_FAILURE;
-    }
-
-    SDL_GLContext glContext = SDL_GL_CreateContext(window);
-    if (!glContext) {
-        std::cerr << "Failed to create GL context: " << SDL_GetError() << '\n';
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return EXIT_FAILURE;
+// Everything that owns GL objects lives in here, so it is all destroyed while the
+// context main created is still current.
+int Run(SDL_Window* window, std::chrono::steady_clock::time_point startTime) {
+    // Linked program binaries persist across runs in the per-user data directory.
+    ow::ProgramCache programCache;
+    {
+        char* prefPath = SDL_GetPrefPath("OpenWare", "OpenWareEngine");
+        const std::string cacheDir = prefPath ? std::string(prefPath) + "shader_cache" : std::string("shader_cache");
+        SDL_free(prefPath);
+        if (programCache.Open(cacheDir)) {
+            ow::Shader::SetProgramCache(&programCache);
+        }
     }
 
-    SDL_GL_SetSwapInterval(1);
-    glEnable(GL_DEPTH_TEST);
-
     ow::Input::Init();
     ow::Input::SetRelativeMouseMode(true);
 
-    auto shader = std::make_shared<ow::Shader>();
-    if (!shader->Compile(kVertexShader, kFragmentShader)) {
-        SDL_GL_DeleteContext(glContext);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
+    // Materials draw with specialized variants of the standard shader (see ShaderVariants.hpp);
+    // compiling the base variant up front doubles as the startup shader check.
+    auto shaderVariants = std::make_shared<ow::ShaderVariants>(kVertexShader, kFragmentShader);
+    auto shader = shaderVariants->Get(0);
+    if (!shader) {
         return EXIT_FAILURE;
     }
 
@@ -305,6 +364,8 @@ int main() {
         scriptSystem.LoadScript(ResolveAssetPath("assets/scripts/game.lua"));
     }
 
+    // 16-byte snorm16/half vertices; the low-poly style has no use for full float precision.
+    ow::Mesh::SetDefaultFormat(ow::VertexFormat::Packed);
     auto cubeMesh = ow::Mesh::CreateCube(0.5f);
     auto objMesh = ow::OBJLoader::Load(ResolveAssetPath("assets/cube.obj"));
     if (!objMesh) {
@@ -321,48 +382,75 @@ int main() {
         matTextured = CreateFallbackMaterial(shader, ow::Vec3{0.95f, 0.90f, 0.76f}, 0.55f, ow::Vec3{0.08f, 0.06f, 0.02f}, 0.3f);
     }
 
+    matColor->shaderVariants = shaderVariants;
+    matTextured->shaderVariants = shaderVariants;
+
+    // With parallel compilation every permutation builds on driver threads while the
+    // first frames render (drawing with ready subsets meanwhile); without it each variant
+    // compiles on first use instead of all of them stalling startup.
+    if (ow::Shader::ParallelCompileSupported()) {
+        for (ow::ShaderFeatureMask features = 1; features < 8; ++features) {
+            shaderVariants->Request(features);
+        }
+        shaderVariants->Request(ow::kShaderFeatureDepthOnly);
+        shaderVariants->Request(ow::kShaderFeatureDepthOnly | ow::kShaderFeaturePs2);
+    }
+
     // --- GAME CODE AREA: Scene setup (spawn your game objects here) ---
     ow::Scene scene;
     scene.light.direction = ow::Vec3{-0.35f, -1.0f, -0.25f};
     scene.light.color = ow::Vec3{1.0f, 0.94f, 0.86f};
 
+    ow::Entity groundProbe;
     for (int z = -2; z <= 2; ++z) {
         for (int x = -2; x <= 2; ++x) {
-            auto e = std::make_shared<ow::Entity>("Cube");
-            e->mesh = cubeMesh;
-            e->material = ((x + z) % 2 == 0) ? matColor : matTextured;
-            e->transform.position = ow::Vec3{static_cast<float>(x) * 1.5f, 0.0f, static_cast<float>(z) * 1.5f};
-            e->transform.scale = ow::Vec3{1.0f, 1.0f, 1.0f};
-            e->colliderRadius = 0.75f;
-            e->rigidbody = std::make_shared<ow::Rigidbody>();
-            e->rigidbody->isStatic = true;
-            e->rigidbody->useGravity = false;
-            scene.AddEntity(e);
+            ow::Entity e = scene.CreateEntity("Cube");
+            e.SetRenderable(cubeMesh, ((x + z) % 2 == 0) ? matColor : matTextured);
+            e.GetTransform().SetPosition(ow::Vec3{static_cast<float>(x) * 1.5f, 0.0f, static_cast<float>(z) * 1.5f});
+            e.GetTransform().SetScale(ow::Vec3{1.0f, 1.0f, 1.0f});
+            e.AddCollider(0.75f);
+            ow::Rigidbody* rb = e.AddRigidbody();
+            rb->isStatic = true;
+            rb->useGravity = false;
+            if (!groundProbe) {
+                groundProbe = e;
+            }
         }
     }
 
-    auto hero = std::make_shared<ow::Entity>("HeroOBJ");
-    hero->mesh = objMesh;
-    hero->material = matTextured;
-    hero->transform.position = ow::Vec3{0.0f, 3.2f, 0.0f};
-    hero->transform.scale = ow::Vec3{1.2f, 1.2f, 1.2f};
-    hero->colliderRadius = 0.9f;
-    hero->rigidbody = std::make_shared<ow::Rigidbody>();
-    hero->rigidbody->SetMass(1.25f);
-    hero->rigidbody->restitution = 0.15f;
-    hero->rigidbody->linearDamping = 0.995f;
-    scene.AddEntity(hero);
+    ow::Entity hero = scene.CreateEntity("HeroOBJ");
+    hero.SetRenderable(objMesh, matTextured);
+    hero.GetTransform().SetPosition(ow::Vec3{0.0f, 3.2f, 0.0f});
+    hero.GetTransform().SetScale(ow::Vec3{1.2f, 1.2f, 1.2f});
+    hero.AddCollider(0.9f);
+    ow::Rigidbody* heroBody = hero.AddRigidbody();
+    heroBody->SetMass(1.25f);
+    heroBody->restitution = 0.15f;
+    heroBody->linearDamping = 0.995f;
 
     ow::Camera camera;
+    // Workers for frame preparation; the GL thread only submits. The prepare thread is
+    // the loops' caller and the GL thread stays busy submitting, so leave a core for each.
+    const unsigned int workerCount = ow::JobSystem::DefaultWorkerCount();
+    ow::JobSystem jobs(workerCount > 0 ? workerCount - 1 : 0);
     ow::Renderer renderer;
+    renderer.SetJobSystem(&jobs);
+    // Runs Prepare for the next frame while this thread submits the current one.
+    ow::WorkerThread prepareThread;
+    // Pass timings for the HUD; results arrive a few frames late so nothing stalls.
+    ow::GpuProfiler gpuProfiler;
+    renderer.SetGpuProfiler(&gpuProfiler);
+    AddPs2PostEffects(renderer.PostEffects());
+    // Scale for ResolutionMode::Dynamic, aiming at a 60 Hz frame.
+    ow::DynamicResolution dynamicResolution;
+    // The ground grid never moves: merge it into one mesh per material.
+    scene.UpdateTransforms();
+    renderer.BuildStaticBatches(scene);
     ow::DebugUI debugUi;
     if (!debugUi.Init()) {
         std::cerr << "Failed to initialize debug UI\n";
         scriptSystem.Shutdown();
         ow::AudioSystem::Shutdown();
-        SDL_GL_DeleteContext(glContext);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
         return EXIT_FAILURE;
     }
 
@@ -372,6 +460,7 @@ int main() {
     bool settingsOpen = false;
     bool prevSettingsOpen = false;
     bool appliedVsync = true;
+    bool firstFrameReported = false;
     bool musicPlaying = bgm.native != nullptr;
 
     const float fixedDeltaTime = 1.0f / 60.0f;
@@ -380,6 +469,7 @@ int main() {
     float lastTime = static_cast<float>(SDL_GetTicks()) * 0.001f;
 
     while (running) {
+        const auto frameStart = std::chrono::steady_clock::now();
         // --- GAME CODE AREA: Per-frame update (rules, AI, gameplay logic) ---
         const float now = static_cast<float>(SDL_GetTicks()) * 0.001f;
         float frameDelta = now - lastTime;
@@ -401,6 +491,14 @@ int main() {
             if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_P) {
                 gameState.TogglePause();
             }
+
+            if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F3) {
+                if (gpuProfiler.ExportCsv("gpu_profile.csv")) {
+                    std::cout << "GPU profile written to gpu_profile.csv\n";
+                } else {
+                    std::cerr << "Failed to write gpu_profile.csv\n";
+                }
+            }
         }
 
         if (settingsOpen != prevSettingsOpen) {
@@ -417,8 +515,8 @@ int main() {
             if (ow::Input::KeyDown(SDL_SCANCODE_Q)) camera.position += ow::Vec3{0.0f, -moveSpeed, 0.0f};
             if (ow::Input::KeyDown(SDL_SCANCODE_E)) camera.position += ow::Vec3{0.0f, moveSpeed, 0.0f};
 
-            if (ow::Input::KeyDown(SDL_SCANCODE_SPACE) && hero->rigidbody) {
-                hero->rigidbody->AddImpulse(ow::Vec3{0.0f, 8.0f, 0.0f});
+            if (ow::Input::KeyDown(SDL_SCANCODE_SPACE) && hero.GetRigidbody()) {
+                hero.GetRigidbody()->AddImpulse(ow::Vec3{0.0f, 8.0f, 0.0f});
                 ow::AudioSystem::PlaySfx(jumpSfx);
             }
 
@@ -429,8 +527,8 @@ int main() {
             accumulator += frameDelta;
             while (accumulator >= fixedDeltaTime) {
                 const float scriptedImpulse = scriptSystem.CallNumberFunction("ComputeHeroImpulse", fixedDeltaTime, simulationTime, 0.0f);
-                if (hero->rigidbody && scriptedImpulse != 0.0f) {
-                    hero->rigidbody->AddImpulse(ow::Vec3{0.0f, scriptedImpulse, 0.0f});
+                if (hero.GetRigidbody() && scriptedImpulse != 0.0f) {
+                    hero.GetRigidbody()->AddImpulse(ow::Vec3{0.0f, scriptedImpulse, 0.0f});
                 }
 
                 ow::PhysicsSystem::Step(scene, fixedDeltaTime, 2);
@@ -441,8 +539,8 @@ int main() {
 
         debugUi.Tick(frameDelta);
 
-        if (scene.entities.size() > 1) {
-            const bool collides = ow::PhysicsSystem::CheckSphereCollision(*scene.entities[0], *hero);
+        if (groundProbe) {
+            const bool collides = ow::PhysicsSystem::CheckSphereCollision(groundProbe, hero);
             std::string title = collides ? "OpenWare - Collision: YES" : "OpenWare - Collision: NO";
             if (gameState.IsPaused()) {
                 title += " [PAUSED]";
@@ -471,10 +569,58 @@ int main() {
             }
         }
 
-        renderer.Render(scene, camera, width, height, settings);
-        debugUi.Render(settingsOpen);
+        const bool dynamicScale = settings.resolutionMode == ow::ResolutionMode::Dynamic;
+        ow::RenderSettings frameSettings = settings;
+        if (dynamicScale) {
+            frameSettings.resolutionScale = dynamicResolution.Scale();
+            debugUi.SetDynamicResolution(dynamicResolution.Stats());
+        } else {
+            dynamicResolution.Reset();
+            debugUi.SetDynamicResolution(ow::DynamicResolutionStats{});
+        }
+
+        scene.UpdateTransforms();
+        gpuProfiler.BeginFrame();
+        // This frame is prepared on the prepare thread (which fans out to the job system)
+        // while the GL thread submits the previous one, so the picture is a frame behind
+        // the simulation. The very first frame has nothing to overlap and is prepared inline.
+        if (!renderer.HasFrame()) {
+            renderer.Prepare(scene, camera, width, height, frameSettings);
+            renderer.Swap();
+        }
+        prepareThread.Post([&] { renderer.Prepare(scene, camera, width, height, frameSettings); });
+        renderer.Submit();
+        prepareThread.Wait();
+        renderer.Swap();
+        debugUi.SetRenderStats(renderer.Stats());
+        debugUi.SetGpuTimings(gpuProfiler.Timings());
+        {
+            ow::GpuScope uiScope(&gpuProfiler, "UI");
+            debugUi.Render(settingsOpen);
+        }
+        gpuProfiler.EndFrame();
+
+        if (dynamicScale) {
+            // Top-level scopes cover the whole GPU frame; the CPU side stops short of the swap.
+            float gpuMs = 0.0f;
+            for (const ow::GpuTiming& timing : gpuProfiler.Timings()) {
+                if (timing.depth == 0) {
+                    gpuMs += timing.ms;
+                }
+            }
+            const float cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            dynamicResolution.Update(cpuMs, gpuMs);
+        }
 
         SDL_GL_SwapWindow(window);
+
+        if (!firstFrameReported) {
+            firstFrameReported = true;
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            std::cout << "First frame after " << ms << " ms (program cache " << programCache.Hits() << " hits, "
+                      << programCache.Misses() << " misses, " << shaderVariants->PendingCount()
+                      << " variants still compiling)\n";
+        }
     }
 
     auto releaseMaterialTextures = [](const std::shared_ptr<ow::Material>& material) {
@@ -505,8 +651,59 @@ int main() {
     scriptSystem.Shutdown();
 
     debugUi.Shutdown();
+    ow::Shader::SetProgramCache(nullptr);
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main() {
+    // Cold start to first presented frame, reported once after the first swap.
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+
+    SDL_Window* window = SDL_CreateWindow(
+        "OpenWare - Retro RenderWare Style",
+        SDL_WINDOWPOS_CENTERED,
+        SDL_WINDOWPOS_CENTERED,
+        1280,
+        720,
+        SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+
+    if (!window) {
+        std::cerr << "Failed to create window: " << SDL_GetError() << '\n';
+        SDL_Quit();
+        return EXIT_FAILURE;
+    }
+
+    SDL_GLContext glContext = SDL_GL_CreateContext(window);
+    if (!glContext) {
+        std::cerr << "Failed to create GL context: " << SDL_GetError() << '\n';
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return EXIT_FAILURE;
+    }
+
+    SDL_GL_SetSwapInterval(1);
+    glEnable(GL_DEPTH_TEST);
+
+    const int result = Run(window, startTime);
+
+    // The shared mesh arenas are function-local statics and would otherwise be
+    // destroyed after the context is gone.
+    ow::MeshArena::ShutdownShared();
     SDL_GL_DeleteContext(glContext);
     SDL_DestroyWindow(window);
     SDL_Quit();
-    return EXIT_SUCCESS;
+    return result;
 }